@@ -0,0 +1,38 @@
+# easyjson_compile_config(<target> <config.json> [NAME <identifier>])
+#
+# Validates <config.json> at build time with the same rules as EasyJsonCPP::loadConfiguration()
+# and generates easyjson_compiled/<identifier>.h for <target>. The header defines the constexpr
+# object easyjson::compiled::<identifier> (see include/easyjson_compiled.h). The identifier
+# defaults to the file name without its extensions. An invalid configuration fails the build
+# with file:line:column errors.
+
+# Cached so the function also works from a parent project that adds this one as a subdirectory.
+set(EASYJSON_INCLUDE_DIR "${CMAKE_CURRENT_LIST_DIR}/../include" CACHE INTERNAL "EasyJsonCPP headers")
+
+function(easyjson_compile_config target config)
+    cmake_parse_arguments(ARG "" "NAME" "" ${ARGN})
+
+    get_filename_component(input "${config}" ABSOLUTE BASE_DIR "${CMAKE_CURRENT_SOURCE_DIR}")
+    if(NOT ARG_NAME)
+        get_filename_component(ARG_NAME "${config}" NAME_WE)
+        string(MAKE_C_IDENTIFIER "${ARG_NAME}" ARG_NAME)
+    endif()
+
+    set(outputDir "${CMAKE_CURRENT_BINARY_DIR}/easyjson_compiled")
+    set(output "${outputDir}/${ARG_NAME}.h")
+    file(MAKE_DIRECTORY "${outputDir}")
+
+    add_custom_command(
+        OUTPUT "${output}"
+        COMMAND easyjson_compile "${input}" "${output}" "${ARG_NAME}"
+        DEPENDS "${input}" easyjson_compile
+        COMMENT "Compiling configuration ${config}"
+        VERBATIM
+    )
+
+    target_sources(${target} PRIVATE "${output}")
+    target_include_directories(${target} PRIVATE
+        "${CMAKE_CURRENT_BINARY_DIR}"
+        "${EASYJSON_INCLUDE_DIR}"
+    )
+endfunction()
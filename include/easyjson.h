@@ -28,11 +28,45 @@
 #ifndef EASYJSONCPP_H
 #define EASYJSONCPP_H
 
+#include <deque>
+#include <future>
 #include <unordered_map>
 #include <header.h>
+#include <easyjson_intern.h>
+#include <easyjson_profile.h>
+#include <easyjson_arrays.h>
 
 namespace easyjson
 {
+    // Error codes reported by the non-throwing validation path.
+    enum class ErrorCode
+    {
+        None,
+        FileError,          // The file could not be opened.
+        SyntaxError,        // The text is not valid JSON.
+        InvalidRoot,        // The root is neither an array nor an object.
+        EmptyRoot,          // The root array is empty.
+        InvalidObject,      // An element that must be an object is not.
+        EmptyObject,        // A root element is an empty object.
+        InvalidMemberValue, // A section is neither an array nor an object.
+        InvalidValue        // A value is neither a string nor an integer.
+    };
+
+    struct ValidationError
+    {
+        ErrorCode code{ErrorCode::None};
+        std::size_t line{0};   // 1-based, 0 when unknown.
+        std::size_t column{0}; // 1-based, 0 when unknown.
+        std::string path;      // JSON path of the offending value, e.g. $[3].twitter.port
+        std::string message;
+    };
+
+    struct ValidationResult
+    {
+        std::vector<ValidationError> errors;
+        bool ok() const { return errors.empty(); }
+    };
+
     class EasyJsonCPP
     {
     public:
@@ -49,6 +83,33 @@ namespace easyjson
                            std::unordered_map<std::string, std::string>>
         loadConfiguration();
 
+        // Loads the configuration off the calling thread; keep this object alive until the future is ready.
+        std::future<std::unordered_map<std::string,
+                                       std::unordered_map<std::string, std::string>>>
+        loadConfigurationAsync();
+
+        // Loads a configuration held in memory. Values are views into the buffer, which must
+        // outlive this object's use of them; the owning variant keeps the text alive itself.
+        const std::unordered_map<std::string_view,
+                                 std::unordered_map<std::string_view, std::string_view>> &
+        loadFromBuffer(std::string_view buffer);
+        const std::unordered_map<std::string_view,
+                                 std::unordered_map<std::string_view, std::string_view>> &
+        loadFromOwnedBuffer(std::string buffer);
+        std::string_view getFromBuffer(std::string_view member, std::string_view key) const;
+        // Drops every value loaded from a buffer, and the owned buffers with them.
+        void clearBufferStore();
+        // Bytes of owned buffer text still kept because some value refers to it.
+        std::size_t ownedBufferBytes() const;
+
+        // Non-throwing validation: reports line, column and JSON path of each error instead of throwing.
+        // With collectAll, every structural error is reported in one pass instead of only the first.
+        static ValidationResult validate(std::string_view content, bool collectAll = false);
+        static ValidationResult validateFile(const std::string &path, bool collectAll = false);
+        ValidationResult tryLoadConfiguration(bool collectAll = false);
+        static const char *errorMessage(ErrorCode code);
+        static const char *errorCodeName(ErrorCode code);
+
         // Methods to parse the Json configuration file.
         void validateRootObject(const Json::Value &root);
         void parseArrayObjectData(const Json::Value &root);
@@ -62,6 +123,50 @@ namespace easyjson
 
         ~EasyJsonCPP() = default;
 
+        // Copies own their data: views and indexes are rebased onto the copy's storage.
+        EasyJsonCPP(const EasyJsonCPP &other);
+        EasyJsonCPP &operator=(const EasyJsonCPP &other);
+        EasyJsonCPP(EasyJsonCPP &&other) = default;
+        EasyJsonCPP &operator=(EasyJsonCPP &&other) = default;
+
+        // String interning: identical section names, keys and values are stored once.
+        // When enabled, loaded data goes to the interned store instead of _mainMap, and
+        // loadConfiguration() throws: use loadInterned() instead.
+        void setInterning(bool enabled) { _interning = enabled; }
+        std::size_t loadInterned();
+        bool isInterning() const { return _interning; }
+        std::string_view getInterned(std::string_view member, std::string_view key) const;
+        StringPool::Id getInternedId(std::string_view member, std::string_view key) const;
+        const StringPool &stringPool() const { return _stringPool; }
+
+        // Secondary value indexes over _mainMap: for a declared key, value -> sections holding it.
+        // Declare before loading to build them during the load; they are kept up to date on reload.
+        void addIndex(const std::string &key);
+        bool hasIndex(const std::string &key) const { return _valueIndexes.count(key) != 0; }
+        const std::vector<std::string_view> &findSections(const std::string &key, const std::string &value) const;
+        std::vector<std::string_view> scanSections(const std::string &key, const std::string &value) const;
+        std::size_t indexMemoryUsage() const;
+
+        // Numeric array values, packed into contiguous int64 or double buffers during the load.
+        const NumericArray *findArray(const std::string &member, const std::string &key) const;
+        ArrayView<std::int64_t> getInt64Array(const std::string &member, const std::string &key) const;
+        ArrayView<double> getDoubleArray(const std::string &member, const std::string &key) const;
+        const std::unordered_map<std::string, std::unordered_map<std::string, NumericArray>> &numericArrays() const
+        {
+            return _arrayMap;
+        }
+
+        // Profiled lookup in _mainMap, served from the hot-key cache when the key is hot.
+        std::string_view lookup(const std::string &member, const std::string &key) const;
+
+        // Hot-key layout: packs the hottest entries (from the profiler or a saved profile) together.
+        // The last layout (or a profile loaded with loadProfile()) is applied again after every load.
+        void optimizeLayout(std::size_t maxKeys = 32);
+        void optimizeLayout(const std::vector<HotKey> &hotKeys, std::size_t maxKeys = 32);
+        void saveProfile(const std::string &path, std::size_t top = 64) const;
+        void loadProfile(const std::string &path);
+        const HotKeyCache &hotKeyCache() const { return _hotCache; }
+
         /// NOTES: For integration testing purposes.
         void displayMap(const std::unordered_map<std::string, std::string> &configMap);
         void displayMap(const std::unordered_map<std::string, std::unordered_map<std::string, std::string>> &configMap);
@@ -77,8 +182,55 @@ namespace easyjson
     private:
         bool initialized{true}; 
         std::string _configFile{};
+        bool _interning{false};
+        StringPool _stringPool;
+        StringPool::Id _lastMemberId{StringPool::npos};
+        std::unordered_map<StringPool::Id,
+                           std::unordered_map<StringPool::Id, StringPool::Id>>
+            _internedMap;
         static std::shared_ptr<spdlog::logger> _logger;
 
+        // Buffer loading: the text being parsed, and owned copies handed to loadFromOwnedBuffer().
+        bool _bufferMode{false};
+        std::string_view _source{};
+        // A list never relocates its strings, and buffers no view refers to can be dropped anywhere.
+        std::list<std::string> _ownedBuffers;
+        std::unordered_map<std::string_view,
+                           std::unordered_map<std::string_view, std::string_view>>
+            _viewMap;
+
+        // Per indexed key: value -> names of the sections holding that value (views of _mainMap
+        // keys), and each section's slot in its list so a reload moves it in O(1).
+        struct ValueIndex
+        {
+            std::unordered_map<std::string, std::vector<std::string_view>> sections;
+            std::unordered_map<std::string_view, std::size_t> positions;
+
+            void insert(const std::string &value, std::string_view member);
+            void erase(const std::string &value, std::string_view member);
+        };
+        std::unordered_map<std::string, ValueIndex> _valueIndexes;
+
+        // Member -> key -> packed numeric array; arrays are never stored as strings.
+        std::unordered_map<std::string, std::unordered_map<std::string, NumericArray>> _arrayMap;
+
+        std::vector<HotKey> _hotKeys;
+        std::size_t _hotKeyLimit{32};
+        HotKeyCache _hotCache;
+
+        void indexValue(const std::string &member, const std::string &key,
+                        const std::string *previous, const std::string &value);
+        void releaseUnusedBuffers();
+        void applyLayout();
+        void eraseScalar(const std::string &member, const std::string &key);
+        void eraseArray(const std::string &member, const std::string &key);
+        void parseDocument(std::string_view content);
+        static ValidationResult validateDocument(std::string_view content, bool collectAll, Json::Value &root);
+        std::string_view sourceView(const Json::Value &value);
+        std::unordered_map<std::string,
+                           std::unordered_map<std::string, std::string>>
+        parseConfiguration(const std::string &content);
+
         // NOTE: This function recursively calculates the hash value of a null-terminated string
         // using a simple algorithm: multiplying the current hash value by 31 and adding
         // the ASCII value of the current character.
@@ -0,0 +1,94 @@
+/**
+ * @file easyjson_arrays.h
+ *
+ * Packed numeric arrays for array values (routing weights, rate-limit tables, histogram
+ * bucket boundaries).
+ *
+ * A homogeneous numeric array is converted once during the load into one contiguous, 64-byte
+ * aligned buffer: int64 when every element is an integer, double as soon as one element is
+ * written as a real number. ArrayView exposes the buffer like std::span (C++20), so consumers
+ * can scan it directly with vectorized code instead of converting per-element strings.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#ifndef EASYJSON_ARRAYS_H
+#define EASYJSON_ARRAYS_H
+
+#include <header.h>
+#include <cstdint>
+#include <memory>
+
+namespace easyjson
+{
+    // Read-only view of a contiguous array; the std::span subset needed by consumers.
+    template <typename T>
+    class ArrayView
+    {
+    public:
+        constexpr ArrayView() = default;
+        constexpr ArrayView(const T *data, std::size_t size) : _data(data), _size(size) {}
+
+        constexpr const T *data() const { return _data; }
+        constexpr std::size_t size() const { return _size; }
+        constexpr bool empty() const { return _size == 0; }
+        constexpr const T *begin() const { return _data; }
+        constexpr const T *end() const { return _data + _size; }
+        constexpr const T &operator[](std::size_t index) const { return _data[index]; }
+        constexpr const T &front() const { return _data[0]; }
+        constexpr const T &back() const { return _data[_size - 1]; }
+
+    private:
+        const T *_data{nullptr};
+        std::size_t _size{0};
+    };
+
+    class NumericArray
+    {
+    public:
+        enum class Type
+        {
+            Int64,
+            Double
+        };
+
+        // Buffers are aligned (and padded) to this many bytes.
+        static constexpr std::size_t kAlignment = 64;
+
+        NumericArray() = default;
+        NumericArray(const NumericArray &other);
+        NumericArray &operator=(const NumericArray &other);
+        // A moved-from array is empty.
+        NumericArray(NumericArray &&other) noexcept;
+        NumericArray &operator=(NumericArray &&other) noexcept;
+
+        // True for arrays whose elements are all integers (within int64) or real numbers.
+        static bool isNumeric(const Json::Value &value);
+
+        // @throw std::runtime_error If the value is not a numeric array (see isNumeric()).
+        static NumericArray fromJson(const Json::Value &value);
+
+        Type type() const { return _type; }
+        std::size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+        // @throw std::runtime_error If the array holds the other type.
+        ArrayView<std::int64_t> int64s() const;
+        ArrayView<double> doubles() const;
+
+    private:
+        struct AlignedDelete
+        {
+            void operator()(void *memory) const { std::free(memory); }
+        };
+
+        // Allocates the zeroed, padded buffer for _size elements.
+        void allocate();
+
+        Type _type{Type::Int64};
+        std::size_t _size{0};
+        std::unique_ptr<void, AlignedDelete> _data;
+    };
+} // ! EasyJson namespace
+
+#endif // EASYJSON_ARRAYS_H
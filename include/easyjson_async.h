@@ -0,0 +1,71 @@
+/**
+ * @file easyjson_async.h
+ *
+ * Asynchronous file reading and worker pool used by EasyJsonCPP::loadConfigurationAsync().
+ *
+ * On Linux the file reads are submitted through a shared io_uring instance that is driven
+ * directly through the kernel interface (no liburing dependency). When the ring cannot be
+ * created (old kernel, seccomp policy, non-Linux platform) the reads fall back to blocking
+ * reads executed on the worker pool. Parsing always runs on the worker pool.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#ifndef EASYJSON_ASYNC_H
+#define EASYJSON_ASYNC_H
+
+#include <header.h>
+#include <deque>
+#include <future>
+
+namespace easyjson
+{
+    namespace detail
+    {
+        /// Callback invoked once a file has been read; error is null on success.
+        using ReadCallback = std::function<void(std::string content, std::exception_ptr error)>;
+
+        class ThreadPool
+        {
+        public:
+            static ThreadPool &instance();
+
+            void post(std::function<void()> task);
+            std::size_t size() const { return _workers.size(); }
+
+            ThreadPool(const ThreadPool &) = delete;
+            ThreadPool &operator=(const ThreadPool &) = delete;
+            ~ThreadPool();
+
+        private:
+            explicit ThreadPool(std::size_t workers);
+            void run();
+
+            std::vector<std::thread> _workers;
+            std::deque<std::function<void()>> _tasks;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            bool _stopping{false};
+        };
+
+        /** @brief
+         * Reads the whole file asynchronously and invokes the callback with its content.
+         * The callback runs on the io_uring completion thread or on a pool worker, so it
+         * must not block; hand heavy work over to ThreadPool::instance().
+         */
+        void readFileAsync(const std::string &path, ReadCallback callback);
+
+        /// True when file reads are served by io_uring rather than the pool fallback.
+        bool ioUringAvailable();
+
+        /** @brief
+         * Routes later reads through io_uring (the default) or always through the pool
+         * fallback. Meant for tests; setting EASYJSON_DISABLE_IO_URING has the same effect
+         * as calling it with false at startup. Reads already submitted are not affected.
+         */
+        void setIoUringEnabled(bool enabled);
+
+    } // ! detail namespace
+} // ! EasyJson namespace
+
+#endif // EASYJSON_ASYNC_H
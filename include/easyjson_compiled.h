@@ -0,0 +1,120 @@
+/**
+ * @file easyjson_compiled.h
+ *
+ * Configurations compiled into the program at build time.
+ *
+ * easyjson_compile_config() (cmake/EasyJsonCompileConfig.cmake) validates a configuration file
+ * with the same rules as EasyJsonCPP::loadConfiguration() and generates a header holding its
+ * entries as a constexpr array sorted by section and key, plus a precomputed open-addressing
+ * hash table over them. All lookups are constexpr: with constant arguments they are resolved
+ * by the compiler, otherwise they cost one hash and usually one comparison. There is nothing
+ * to construct, read or parse at startup.
+ *
+ * This header only depends on the standard library, so generated headers can be used without
+ * jsoncpp or spdlog.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#ifndef EASYJSON_COMPILED_H
+#define EASYJSON_COMPILED_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace easyjson
+{
+    struct CompiledEntry
+    {
+        std::string_view section;
+        std::string_view key;
+        std::string_view value;
+    };
+
+    class CompiledConfig
+    {
+    public:
+        // The entries are sorted by section, then key; slots holds entry index + 1 (0 = empty)
+        // at the position of each entry's hash, with linear probing. Both are generated.
+        template <std::size_t N, std::size_t S>
+        constexpr CompiledConfig(const CompiledEntry (&entries)[N], const std::uint32_t (&slots)[S])
+            : _entries(entries), _size(N), _slots(slots), _mask(S - 1)
+        {
+            static_assert(S > N && (S & (S - 1)) == 0, "The slot count must be a power of two above the entry count.");
+        }
+
+        // 32-bit FNV-1a over section, a separator and key; shared with the generator.
+        static constexpr std::uint32_t hash(std::string_view section, std::string_view key)
+        {
+            std::uint32_t hash = 2166136261u;
+            for (const char c : section)
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+            }
+            hash = (hash ^ 0xffu) * 16777619u;
+            for (const char c : key)
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+            }
+            return hash;
+        }
+
+        constexpr std::optional<std::string_view> find(std::string_view section, std::string_view key) const
+        {
+            for (std::size_t index = hash(section, key) & _mask; _slots[index] != 0; index = (index + 1) & _mask)
+            {
+                const CompiledEntry &entry = _entries[_slots[index] - 1];
+                if (entry.key == key && entry.section == section)
+                {
+                    return entry.value;
+                }
+            }
+            return std::nullopt;
+        }
+
+        constexpr bool contains(std::string_view section, std::string_view key) const
+        {
+            return find(section, key).has_value();
+        }
+
+        // Throws like the other stores; in a constant expression a missing entry is a compile error.
+        constexpr std::string_view get(std::string_view section, std::string_view key) const
+        {
+            const std::optional<std::string_view> value = find(section, key);
+            if (!value)
+            {
+                throw std::runtime_error("Error retrieving " + std::string(section) + "." + std::string(key) +
+                                         " from compiled config");
+            }
+            return *value;
+        }
+
+        constexpr std::size_t size() const { return _size; }
+        constexpr const CompiledEntry *begin() const { return _entries; }
+        constexpr const CompiledEntry *end() const { return _entries + _size; }
+
+        // Materializes the entries as a plain map, as returned by loadConfiguration().
+        std::unordered_map<std::string, std::unordered_map<std::string, std::string>> toMap() const
+        {
+            std::unordered_map<std::string, std::unordered_map<std::string, std::string>> configMap;
+            for (const CompiledEntry &entry : *this)
+            {
+                configMap[std::string(entry.section)].emplace(entry.key, entry.value);
+            }
+            return configMap;
+        }
+
+    private:
+        const CompiledEntry *_entries;
+        std::size_t _size;
+        const std::uint32_t *_slots;
+        std::size_t _mask;
+    };
+} // ! EasyJson namespace
+
+#endif // EASYJSON_COMPILED_H
@@ -0,0 +1,51 @@
+/**
+ * @file easyjson_compress.h
+ *
+ * Transparent reading of compressed configuration files.
+ *
+ * The format is detected from the magic bytes, not the file extension: gzip (and zlib-wrapped
+ * deflate) through zlib, and zstd when the library is built with EASYJSON_WITH_ZSTD. The
+ * compressed input is streamed through a fixed-size window, and the decompressed text is
+ * written straight into the buffer handed to the parser, sized up front from the gzip trailer
+ * or the zstd frame header. Uncompressed files are read in one pass into a buffer of the file
+ * size.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#ifndef EASYJSON_COMPRESS_H
+#define EASYJSON_COMPRESS_H
+
+#include <header.h>
+#include <string_view>
+
+namespace easyjson
+{
+    namespace detail
+    {
+        enum class Compression
+        {
+            None,
+            Gzip,
+            Zstd
+        };
+
+        /// Detects the compression format from the first bytes of the data.
+        Compression detectCompression(std::string_view head);
+
+        /** @brief
+         * Reads a configuration file, decompressing it if needed.
+         * @throw std::runtime_error If the file cannot be opened or the compressed data is corrupt.
+         */
+        std::string readConfigFile(const std::string &path);
+
+        /** @brief
+         * Decompresses data already in memory; uncompressed data is returned unchanged.
+         * @throw std::runtime_error If the compressed data is corrupt.
+         */
+        std::string decompress(std::string content, const std::string &name);
+
+    } // ! detail namespace
+} // ! EasyJson namespace
+
+#endif // EASYJSON_COMPRESS_H
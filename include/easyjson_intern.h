@@ -0,0 +1,60 @@
+/**
+ * @file easyjson_intern.h
+ *
+ * String interning pool used by EasyJsonCPP to store repeated section names, keys and values once.
+ * Every distinct string is copied a single time into an append-only arena and identified by a
+ * small integer ID, so equality checks between interned strings become ID comparisons.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#ifndef EASYJSON_INTERN_H
+#define EASYJSON_INTERN_H
+
+#include <header.h>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace easyjson
+{
+    class StringPool
+    {
+    public:
+        using Id = std::uint32_t;
+        static constexpr Id npos = static_cast<Id>(-1);
+
+        StringPool() = default;
+        StringPool(const StringPool &other);
+        StringPool &operator=(const StringPool &other);
+        // A moved-from pool is empty and can be reused.
+        StringPool(StringPool &&other);
+        StringPool &operator=(StringPool &&other);
+
+        // Returns the ID of the string, copying it into the pool the first time it is seen.
+        Id intern(std::string_view value);
+
+        // Returns the ID of an already interned string, or npos.
+        Id find(std::string_view value) const;
+
+        // The returned view stays valid for the lifetime of the pool.
+        std::string_view view(Id id) const { return _views.at(id); }
+
+        std::size_t size() const { return _views.size(); }
+        std::size_t memoryUsage() const;
+        void clear();
+
+    private:
+        static constexpr std::size_t kBlockSize = 16 * 1024;
+
+        std::vector<std::unique_ptr<char[]>> _blocks;
+        char *_current{nullptr};
+        std::size_t _blockUsed{0};
+        std::size_t _arenaBytes{0};
+        std::vector<std::string_view> _views;
+        std::unordered_map<std::string_view, Id> _index;
+    };
+} // ! EasyJson namespace
+
+#endif // EASYJSON_INTERN_H
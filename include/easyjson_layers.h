@@ -0,0 +1,70 @@
+/**
+ * @file easyjson_layers.h
+ *
+ * Layered configurations: a base snapshot plus override layers.
+ * Sections are immutable and reference counted, so a layer only allocates the sections it
+ * overrides (copy-on-write at section granularity) and shares every other section with the
+ * layer below it. Each layer keeps a merged section index, so a lookup costs two hash
+ * lookups whatever the number of layers.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#ifndef EASYJSON_LAYERS_H
+#define EASYJSON_LAYERS_H
+
+#include <header.h>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+
+namespace easyjson
+{
+    struct ConfigSection
+    {
+        std::string name;
+        std::unordered_map<std::string, std::string> values;
+    };
+
+    class LayeredConfig
+    {
+    public:
+        using SectionPtr = std::shared_ptr<const ConfigSection>;
+
+        LayeredConfig();
+
+        // Builds the base layer, typically from EasyJsonCPP::loadConfiguration().
+        static LayeredConfig fromMap(const std::unordered_map<std::string,
+                                                              std::unordered_map<std::string, std::string>> &configMap);
+
+        // Returns a new layer on top of this one; sections not named in overrides are shared.
+        LayeredConfig withOverrides(const std::unordered_map<std::string,
+                                                             std::unordered_map<std::string, std::string>> &overrides) const;
+
+        // Section maps are keyed by std::string: the std::string overloads look keys up without a
+        // temporary copy, the std::string_view ones build one (no heterogeneous lookup in C++17).
+        const std::string *find(std::string_view section, const std::string &key) const;
+        const std::string *find(std::string_view section, std::string_view key) const;
+        const std::string *find(std::string_view section, const char *key) const { return find(section, std::string_view(key)); }
+        const std::string &get(std::string_view section, const std::string &key) const;
+        const std::string &get(std::string_view section, std::string_view key) const;
+        const std::string &get(std::string_view section, const char *key) const { return get(section, std::string_view(key)); }
+        SectionPtr section(std::string_view name) const;
+
+        bool sharesSection(const LayeredConfig &other, std::string_view name) const;
+        std::size_t sectionCount() const { return _index->size(); }
+        std::size_t layerCount() const { return _layers; }
+
+        // Materializes the merged view as a plain map, as returned by loadConfiguration().
+        std::unordered_map<std::string, std::unordered_map<std::string, std::string>> toMap() const;
+
+    private:
+        // Keys are views of the section's own name, kept alive by the mapped pointer.
+        using Index = std::unordered_map<std::string_view, SectionPtr>;
+
+        std::shared_ptr<const Index> _index;
+        std::size_t _layers{0};
+    };
+} // ! EasyJson namespace
+
+#endif // EASYJSON_LAYERS_H
@@ -0,0 +1,130 @@
+/**
+ * @file easyjson_profile.h
+ *
+ * Access-frequency profiling for configuration lookups, and a compact cache that packs the
+ * hottest entries into a few cache lines.
+ *
+ * KeyProfiler samples one lookup out of N per thread into a per-thread table, so the lookup
+ * path only pays a relaxed load and a thread-local decrement between samples. The merged
+ * report can be dumped, saved as JSON and loaded again on the next start.
+ *
+ * HotKeyCache holds copies of the hottest section/key/value entries: a small open-addressing
+ * table of 16-byte slots (four per cache line) in front of one contiguous string arena.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#ifndef EASYJSON_PROFILE_H
+#define EASYJSON_PROFILE_H
+
+#include <header.h>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace easyjson
+{
+    struct HotKey
+    {
+        std::string section;
+        std::string key;
+        std::uint64_t count{0};
+    };
+
+    class KeyProfiler
+    {
+    public:
+        static KeyProfiler &instance();
+
+        // Records one lookup out of every sampleEvery, per thread.
+        void enable(std::uint32_t sampleEvery = 64);
+        void disable() { _enabled.store(false, std::memory_order_relaxed); }
+        bool enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+        inline void record(std::string_view section, std::string_view key)
+        {
+            if (!_enabled.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            thread_local std::uint32_t countdown = 0;
+            if (countdown != 0)
+            {
+                --countdown;
+                return;
+            }
+            countdown = sample(section, key);
+        }
+
+        // Estimated access counts (samples x rate), hottest first; top == 0 returns every key.
+        std::vector<HotKey> report(std::size_t top = 0) const;
+        std::string dump(std::size_t top = 20) const;
+        void reset();
+
+        static void save(const std::string &path, const std::vector<HotKey> &hotKeys);
+        static std::vector<HotKey> load(const std::string &path);
+
+    private:
+        struct ThreadTable;
+
+        KeyProfiler() = default;
+        std::uint32_t sample(std::string_view section, std::string_view key);
+
+        std::atomic<bool> _enabled{false};
+        std::atomic<std::uint32_t> _sampleEvery{64};
+        mutable std::mutex _mutex;
+        std::vector<ThreadTable *> _tables; // Tables of live threads.
+        std::unordered_map<std::string, std::uint64_t> _retired; // Counts of exited threads.
+    };
+
+    class HotKeyCache
+    {
+    public:
+        HotKeyCache() = default;
+        HotKeyCache(const HotKeyCache &other);
+        HotKeyCache &operator=(const HotKeyCache &other);
+        // A moved-from cache is empty.
+        HotKeyCache(HotKeyCache &&other) noexcept;
+        HotKeyCache &operator=(HotKeyCache &&other) noexcept;
+
+        // Packs the given entries in order; the value callback returns null for unknown keys.
+        void build(const std::vector<HotKey> &hotKeys,
+                   const std::function<const std::string *(const std::string &, const std::string &)> &value);
+        void clear();
+
+        bool empty() const { return _size == 0; }
+        std::size_t size() const { return _size; }
+        std::size_t footprint() const { return _mask ? (_mask + 1) * sizeof(Slot) + _arenaSize : 0; }
+
+        // Returns true and sets value when the entry is cached.
+        bool find(std::string_view section, std::string_view key, std::string_view &value) const;
+
+    private:
+        struct Slot
+        {
+            std::uint32_t hash;
+            std::uint32_t offset; // Into the arena: section, key, then value bytes.
+            std::uint16_t sectionLength;
+            std::uint16_t keyLength;
+            std::uint32_t valueLength;
+        };
+        static_assert(sizeof(Slot) == 16, "Four slots must share a cache line.");
+
+        struct AlignedDelete
+        {
+            void operator()(void *memory) const { std::free(memory); }
+        };
+
+        static std::uint32_t hash(std::string_view section, std::string_view key);
+        void allocate(std::size_t slotCount, std::size_t arenaSize);
+
+        std::unique_ptr<Slot, AlignedDelete> _slots;
+        std::unique_ptr<char, AlignedDelete> _arena;
+        std::size_t _arenaSize{0};
+        std::size_t _mask{0};
+        std::size_t _size{0};
+    };
+} // ! EasyJson namespace
+
+#endif // EASYJSON_PROFILE_H
@@ -0,0 +1,82 @@
+/**
+ * @file easyjson_shm.h
+ *
+ * Publishes a parsed configuration into POSIX shared memory so pre-forked worker processes
+ * can serve lookups from a single copy instead of each parsing the file.
+ *
+ * Layout: a small control segment (named after the configuration) holds the current
+ * generation number; each generation lives in its own immutable data segment
+ * ("<name>.<generation>"). The data segment only contains offsets, never pointers, so it can
+ * be mapped at any address. Republishing writes a new data segment, then bumps the
+ * generation; readers pick it up on refresh() while already-mapped generations stay valid.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#ifndef EASYJSON_SHM_H
+#define EASYJSON_SHM_H
+
+#include <header.h>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+namespace easyjson
+{
+    class SharedConfigPublisher
+    {
+    public:
+        explicit SharedConfigPublisher(const std::string &name);
+        ~SharedConfigPublisher();
+
+        SharedConfigPublisher(const SharedConfigPublisher &) = delete;
+        SharedConfigPublisher &operator=(const SharedConfigPublisher &) = delete;
+
+        // Writes a new generation and makes it current; returns its generation number.
+        std::uint64_t publish(const std::unordered_map<std::string,
+                                                       std::unordered_map<std::string, std::string>> &configMap);
+        std::uint64_t generation() const;
+
+        // Removes the control and data segments. Attached readers keep their current mapping.
+        void unpublish();
+
+    private:
+        std::string _name;
+        void *_control{nullptr};
+    };
+
+    class SharedConfigReader
+    {
+    public:
+        // Attaches to the current generation.
+        // @throw std::runtime_error If nothing is published under this name.
+        explicit SharedConfigReader(const std::string &name);
+        ~SharedConfigReader();
+
+        SharedConfigReader(const SharedConfigReader &) = delete;
+        SharedConfigReader &operator=(const SharedConfigReader &) = delete;
+
+        // Maps the latest generation if it changed. Returns true when a new generation was mapped;
+        // views returned before that point are then invalid.
+        bool refresh();
+
+        std::optional<std::string_view> find(std::string_view section, std::string_view key) const;
+        std::string_view get(std::string_view section, std::string_view key) const;
+        std::uint64_t generation() const { return _generation; }
+        std::size_t size() const;
+
+        std::unordered_map<std::string, std::unordered_map<std::string, std::string>> toMap() const;
+
+    private:
+        void unmap();
+
+        std::string _name;
+        void *_control{nullptr};
+        const char *_data{nullptr};
+        std::size_t _dataSize{0};
+        std::uint64_t _generation{0};
+    };
+} // ! EasyJson namespace
+
+#endif // EASYJSON_SHM_H
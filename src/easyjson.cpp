@@ -1,23 +1,271 @@
 #include "easyjson.h"
+#include "easyjson_async.h"
+#include "easyjson_compress.h"
 
 namespace easyjson
 {
+    namespace
+    {
+        /** @brief
+         * Non-throwing mirror of validateRootObject() and the parse methods it calls.
+         * Applies the same rules, but records each violation with its position and JSON path
+         * instead of throwing, and optionally keeps going to report every violation.
+         */
+        class DocumentValidator
+        {
+        public:
+            DocumentValidator(std::string_view content, bool collectAll, ValidationResult &result)
+                : _content(content), _collectAll(collectAll), _result(result) {}
+
+            void root(const Json::Value &root)
+            {
+                if (root.isArray())
+                {
+                    arrayObjects(root);
+                }
+                else if (!root.isObject())
+                {
+                    report(ErrorCode::InvalidRoot, root, "$");
+                }
+            }
+
+            void locate(std::size_t offset, ValidationError &error)
+            {
+                if (offset > _content.size())
+                {
+                    return;
+                }
+
+                // Built on the first error only: valid documents never pay for it.
+                if (_lineStarts.empty())
+                {
+                    _lineStarts.push_back(0);
+                    for (std::size_t i = 0; i < _content.size(); ++i)
+                    {
+                        if (_content[i] == '\n')
+                        {
+                            _lineStarts.push_back(i + 1);
+                        }
+                    }
+                }
+
+                const auto line = std::upper_bound(_lineStarts.begin(), _lineStarts.end(), offset) - 1;
+                error.line = static_cast<std::size_t>(line - _lineStarts.begin()) + 1;
+                error.column = offset - *line + 1;
+            }
+
+        private:
+            bool done() const { return !_collectAll && !_result.errors.empty(); }
+
+            void arrayObjects(const Json::Value &rootObjects)
+            {
+                if (rootObjects.empty())
+                {
+                    report(ErrorCode::EmptyRoot, rootObjects, "$");
+                    return;
+                }
+
+                for (Json::ArrayIndex i = 0; i < rootObjects.size() && !done(); ++i)
+                {
+                    const Json::Value &object = rootObjects[i];
+                    const std::string path = "$[" + std::to_string(i) + "]";
+                    if (!object.isObject())
+                    {
+                        report(ErrorCode::InvalidObject, object, path);
+                        continue;
+                    }
+                    if (object.empty())
+                    {
+                        report(ErrorCode::EmptyObject, object, path);
+                        continue;
+                    }
+
+                    for (const auto &member : object.getMemberNames())
+                    {
+                        if (done())
+                        {
+                            return;
+                        }
+
+                        const Json::Value &value = object[member];
+                        const std::string memberPath = childPath(path, member);
+                        if (value.isArray())
+                        {
+                            arrayMember(memberPath, value);
+                        }
+                        else if (value.isObject())
+                        {
+                            objectMember(memberPath, value);
+                        }
+                        else
+                        {
+                            report(ErrorCode::InvalidMemberValue, value, memberPath);
+                        }
+                    }
+                }
+            }
+
+            void arrayMember(const std::string &path, const Json::Value &arrayValue)
+            {
+                for (Json::ArrayIndex i = 0; i < arrayValue.size() && !done(); ++i)
+                {
+                    const Json::Value &object = arrayValue[i];
+                    const std::string elementPath = path + "[" + std::to_string(i) + "]";
+                    if (!object.isObject())
+                    {
+                        report(ErrorCode::InvalidObject, object, elementPath);
+                        continue;
+                    }
+                    objectMember(elementPath, object);
+                }
+            }
+
+            void objectMember(const std::string &path, const Json::Value &objectValue)
+            {
+                for (const auto &key : objectValue.getMemberNames())
+                {
+                    if (done())
+                    {
+                        return;
+                    }
+
+                    const Json::Value &value = objectValue[key];
+                    if (!value.isString() && !value.isInt() && !NumericArray::isNumeric(value))
+                    {
+                        report(ErrorCode::InvalidValue, value, childPath(path, key));
+                    }
+                }
+            }
+
+            static std::string childPath(const std::string &path, const std::string &key)
+            {
+                const bool plain = !key.empty() && std::all_of(key.begin(), key.end(), [](unsigned char c)
+                                                               { return std::isalnum(c) || c == '_'; });
+                return plain ? path + "." + key : path + "[\"" + key + "\"]";
+            }
+
+            void report(ErrorCode code, const Json::Value &at, std::string path)
+            {
+                ValidationError error;
+                error.code = code;
+                error.path = std::move(path);
+                error.message = EasyJsonCPP::errorMessage(code);
+                locate(static_cast<std::size_t>(at.getOffsetStart()), error);
+                _result.errors.push_back(std::move(error));
+            }
+
+            std::string_view _content;
+            bool _collectAll;
+            ValidationResult &_result;
+            std::vector<std::size_t> _lineStarts;
+        };
+
+        // A UTF-8 byte order mark is skipped before parsing, so value offsets index the rest of the text.
+        std::string_view withoutBom(std::string_view content)
+        {
+            return content.substr(0, 3) == "\xEF\xBB\xBF" ? content.substr(3) : content;
+        }
+
+        // The one parser configuration: loading and validation must accept exactly the same text.
+        bool parseJson(std::string_view content, Json::Value &root, std::string &errors)
+        {
+            content = withoutBom(content);
+            Json::CharReaderBuilder builder;
+            const std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+            return reader->parse(content.data(), content.data() + content.size(), &root, &errors);
+        }
+    } // ! anonymous namespace
+
     // std::unordered_map<std::string, std::unordered_map<std::string, std::string>> EasyJsonCPP::_mainMap;
     std::shared_ptr<spdlog::logger> EasyJsonCPP::_logger = spdlog::stdout_color_mt("easyJson");
 
     EasyJsonCPP::EasyJsonCPP(const std::string &configFile)
         : _configFile(configFile)
     {
-        _logger = spdlog::get("EasyJson");
-        if (!_logger)
-        {
-            _logger = spdlog::stdout_color_mt("EasyJson");
-        }
+        // Switch to the "EasyJson" logger once: pool and io_uring threads of an in-flight
+        // asynchronous load read _logger, so later constructors must not write it.
+        static std::once_flag loggerOnce;
+        std::call_once(loggerOnce, []
+                       {
+            auto logger = spdlog::get("EasyJson");
+            if (!logger)
+            {
+                logger = spdlog::stdout_color_mt("EasyJson");
+            }
+            _logger = logger; });
 
         // Show library information
         showLibraryInfo();
     }
 
+    /** @brief
+     * Copies the loaded data. Buffer views into the string pool and owned buffers are rebased
+     * onto the copy's own pool and buffers (views into caller buffers are kept), and value
+     * indexes are rebuilt over the copy's main map, so the copy never refers to the storage of
+     * the original.
+     *
+     * @param other The object to copy.
+     */
+    EasyJsonCPP::EasyJsonCPP(const EasyJsonCPP &other)
+        : _mainMap(other._mainMap),
+          initialized(other.initialized),
+          _configFile(other._configFile),
+          _interning(other._interning),
+          _stringPool(other._stringPool),
+          _lastMemberId(other._lastMemberId),
+          _internedMap(other._internedMap),
+          _bufferMode(other._bufferMode),
+          _ownedBuffers(other._ownedBuffers),
+          _arrayMap(other._arrayMap),
+          _hotKeys(other._hotKeys),
+          _hotKeyLimit(other._hotKeyLimit),
+          _hotCache(other._hotCache)
+    {
+        const auto rebase = [&](std::string_view view)
+        {
+            // Pool IDs survive the copy of the pool.
+            const StringPool::Id id = other._stringPool.find(view);
+            if (id != StringPool::npos && other._stringPool.view(id).data() == view.data())
+            {
+                return _stringPool.view(id);
+            }
+            auto copied = _ownedBuffers.begin();
+            for (const std::string &buffer : other._ownedBuffers)
+            {
+                if (view.data() >= buffer.data() && view.data() + view.size() <= buffer.data() + buffer.size())
+                {
+                    return std::string_view(copied->data() + (view.data() - buffer.data()), view.size());
+                }
+                ++copied;
+            }
+            return view;
+        };
+
+        _source = rebase(other._source);
+        for (const auto &section : other._viewMap)
+        {
+            auto &members = _viewMap[rebase(section.first)];
+            for (const auto &entry : section.second)
+            {
+                members.emplace(rebase(entry.first), rebase(entry.second));
+            }
+        }
+
+        for (const auto &index : other._valueIndexes)
+        {
+            addIndex(index.first);
+        }
+    }
+
+    EasyJsonCPP &EasyJsonCPP::operator=(const EasyJsonCPP &other)
+    {
+        if (this != &other)
+        {
+            *this = EasyJsonCPP(other);
+        }
+        return *this;
+    }
+
     /** @brief
      * Loads the configuration from the specified configuration file.
      * It first checks if the configuration file path is empty.
@@ -44,24 +292,11 @@ namespace easyjson
         {
             _logger->debug("Loading configuration file: {}", _configFile);
 
-            // Open the configuration file
-            std::ifstream file(_configFile);
-            if (!file.is_open())
-            {
-                std::string error_msg = "Could not open config file: " + _configFile;
-                _logger->error(error_msg);
-                throw std::runtime_error(error_msg);
-            }
-
-            // Parse the JSON data
-            Json::Value root;
-            file >> root;
-
-            // Validate the format of the root object and invoke the appropriate parsing method
-            validateRootObject(root);
+            // Read the configuration file; gzip (and zstd) files are decompressed on the fly.
+            const std::string content = detail::readConfigFile(_configFile);
 
-            // Return the map to the caller.
-            return this->_mainMap;
+            // Parse, validate and return the map to the caller.
+            return parseConfiguration(content);
         }
         catch (const std::exception &e)
         {
@@ -72,160 +307,829 @@ namespace easyjson
     }
 
     /** @brief
-     * Validates the root object of the configuration file.
-     * It checks whether the root is an array or an object.
-     * If it's an array, it calls parseArrayObjectData() to parse it.
-     * If it's an object, it may perform additional validation or processing in the future.
-     * If it's neither an array nor an object, it throws a runtime_error.
+     * Asynchronous counterpart of loadConfiguration().
+     * The file is read through io_uring on Linux (or a blocking read on the worker pool when
+     * io_uring is unavailable) and the parsing runs on a worker thread, so the caller can keep
+     * initializing other components while the configuration loads.
+     * Errors are reported through the returned future with the same messages as loadConfiguration().
+     * The object must outlive the returned future, and only one load per object may be in flight.
      *
-     * @param root The root JSON value of the configuration file.
+     * @return A future holding the map containing the parsed configuration data.
      */
-    void EasyJsonCPP::validateRootObject(const Json::Value &root)
+    std::future<std::unordered_map<std::string, std::unordered_map<std::string, std::string>>>
+    EasyJsonCPP::loadConfigurationAsync()
     {
-        _logger->debug("Validating configuration file: {}.", this->_configFile);
-        if (root.isArray())
+        using ConfigMap = std::unordered_map<std::string, std::unordered_map<std::string, std::string>>;
+
+        auto promise = std::make_shared<std::promise<ConfigMap>>();
+        auto future = promise->get_future();
+
+        auto reject = [promise](const std::string &reason)
         {
-            parseArrayObjectData(root);
-        }
-        else if (root.isObject())
+            const std::string error_msg = "Error processing configuration file: " + reason;
+            _logger->error(error_msg);
+            promise->set_exception(std::make_exception_ptr(std::runtime_error(error_msg)));
+        };
+
+        if (_configFile.empty())
         {
-        } // NOTE: Validate other possible formats of a json file here.
-        else
+            const std::string &errorMsg = _configFile + ": file is empty";
+            _logger->error(errorMsg);
+            promise->set_exception(std::make_exception_ptr(std::runtime_error(errorMsg)));
+            return future;
+        }
+
+        _logger->debug("Loading configuration file asynchronously: {}", _configFile);
+
+        detail::readFileAsync(_configFile, [this, promise, reject](std::string content, std::exception_ptr error)
+                              {
+            if (error)
+            {
+                try
+                {
+                    std::rethrow_exception(error);
+                }
+                catch (const std::exception &e)
+                {
+                    reject(e.what());
+                }
+                return;
+            }
+
+            // Keep the I/O completion thread free: parsing happens on a worker.
+            detail::ThreadPool::instance().post([this, promise, reject, content = std::move(content)]() mutable
+                                                {
+                try
+                {
+                    promise->set_value(parseConfiguration(detail::decompress(std::move(content), _configFile)));
+                }
+                catch (const std::exception &e)
+                {
+                    reject(e.what());
+                } }); });
+
+        return future;
+    }
+
+    /** @brief
+     * Parses the JSON text of a configuration file and validates it with validateRootObject().
+     *
+     * @param content The raw JSON text.
+     * @return The main map containing the parsed configuration data.
+     * @throw std::runtime_error If the text is not valid JSON or not a valid configuration.
+     */
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>
+    EasyJsonCPP::parseConfiguration(const std::string &content)
+    {
+        // The interned store is not a map of strings: returning the untouched _mainMap would hide the data.
+        if (_interning)
         {
-            throw std::runtime_error("Config file is not an array of Json objects.");
+            throw std::runtime_error("Interning is enabled: load the configuration with loadInterned()");
         }
+
+        parseDocument(content);
+        return this->_mainMap;
     }
 
     /** @brief
-     * Parses an array of objects from the configuration file rootObjects.
-     * It iterates over each object in the array, verifying that each is indeed an object.
-     * For each object, it iterates over its members and checks whether each member's value is an array or object.
-     * If it's an array, it calls parseArrayMemberData() to process it.
-     * If it's an object, it calls parseObjectMemberData() to process it.
-     * If the value is neither an array nor an object, it throws a runtime_error.
+     * Parses JSON text and validates it with validateRootObject(), filling the active store.
      *
-     * @param rootObjects The JSON array of objects to be parsed.
+     * @param content The raw JSON text.
+     * @throw std::runtime_error If the text is not valid JSON or not a valid configuration.
      */
+    void EasyJsonCPP::parseDocument(std::string_view content)
+    {
+        Json::Value root;
+        std::string errors;
+        if (!parseJson(content, root, errors))
+        {
+            throw std::runtime_error(errors);
+        }
 
-    void EasyJsonCPP::parseArrayObjectData(const Json::Value &rootObjects)
+        // Validate the format of the root object and invoke the appropriate parsing method
+        validateRootObject(root);
+
+        // Values may have changed: lay the remembered hot keys out again.
+        if (!_hotKeys.empty())
+        {
+            applyLayout();
+        }
+    }
+
+    /** @brief
+     * Loads a configuration from a memory buffer (IPC message, shared memory, embedded default).
+     * Section names and keys are interned; values are stored as views. Strings without escape
+     * sequences and integers written in canonical form point straight into the caller's buffer,
+     * anything else is decoded once into the string pool.
+     *
+     * @param buffer The JSON text. It must stay alive and unchanged while the views are used.
+     * @return The map of views containing the parsed configuration data.
+     * @throw std::runtime_error If there's an error processing the buffer.
+     */
+    const std::unordered_map<std::string_view, std::unordered_map<std::string_view, std::string_view>> &
+    EasyJsonCPP::loadFromBuffer(std::string_view buffer)
     {
-        _logger->debug("Parsing configuration file: {}.", this->_configFile);
+        if (buffer.empty())
+        {
+            const std::string errorMsg = "Configuration buffer is empty";
+            _logger->error(errorMsg);
+            throw std::runtime_error(errorMsg);
+        }
 
-        // Check objects.
-        if (rootObjects.empty())
+        _logger->debug("Loading configuration from buffer ({} bytes)", buffer.size());
+
+        // Parse into an empty map and merge it in only on success, so a failed load leaves no
+        // views into a buffer the caller (or loadFromOwnedBuffer()) is about to release.
+        // Numeric arrays are staged the same way.
+        auto committed = std::move(this->_viewMap);
+        this->_viewMap.clear();
+        auto committedArrays = std::move(this->_arrayMap);
+        this->_arrayMap.clear();
+
+        _bufferMode = true;
+        _source = withoutBom(buffer);
+        try
+        {
+            parseDocument(buffer);
+        }
+        catch (const std::exception &e)
         {
-            throw std::runtime_error("Objects in configuration is empty.");
+            _bufferMode = false;
+            _source = {};
+            this->_viewMap = std::move(committed);
+            this->_arrayMap = std::move(committedArrays);
+            std::string error_msg = "Error processing configuration buffer: " + std::string(e.what());
+            _logger->error(error_msg);
+            throw std::runtime_error(error_msg);
         }
+        _bufferMode = false;
+        _source = {};
 
-        for (const auto &object : rootObjects)
+        // Later loads override the keys they contain, as with loadConfiguration(); a key keeps
+        // only its latest value, scalar or array.
+        for (auto &section : this->_viewMap)
         {
-            // Check object format
-            if (!object.isObject())
+            auto &target = committed[section.first];
+            const auto arrays = committedArrays.find(std::string(section.first));
+            for (const auto &entry : section.second)
             {
-                throw std::runtime_error("Invalid format for object in configuration file.");
+                target[entry.first] = entry.second;
+                if (arrays != committedArrays.end())
+                {
+                    arrays->second.erase(std::string(entry.first));
+                }
             }
-
-            // Check if object is empty.
-            //  TODO: skip over empty objects here.
-            if (object.empty())
+            if (arrays != committedArrays.end() && arrays->second.empty())
             {
-                throw std::runtime_error("Empty object in configuration is empty.");
+                committedArrays.erase(arrays);
             }
-
-            // Process object.
-            for (const auto &member : object.getMemberNames())
+        }
+        for (auto &section : this->_arrayMap)
+        {
+            const auto views = committed.find(section.first);
+            for (auto &entry : section.second)
             {
-                const auto &key = object[member];
-
-                if (key.isArray())
-                {
-                    this->parseArrayMemberData(member, key);
-                }
-                else if (key.isObject())
-                {
-                    this->parseObjectMemberData(member, key);
-                }
-                else
+                if (views != committed.end())
                 {
-                    throw std::runtime_error("Invalid format for object value in configuration file.");
+                    views->second.erase(entry.first);
                 }
+                committedArrays[section.first][entry.first] = std::move(entry.second);
             }
         }
+        this->_viewMap = std::move(committed);
+        this->_arrayMap = std::move(committedArrays);
+
+        // Overridden values may have been the last views into an earlier owned buffer.
+        if (!_ownedBuffers.empty())
+        {
+            releaseUnusedBuffers();
+        }
+
+        return this->_viewMap;
     }
 
     /** @brief
-     * Parses data for a member of type array in the configuration file.
-     * It iterates over the elements of the arrayValue, each of which should be an object.
-     * If any element is not an object, it throws a runtime_error.
-     * For each object element, it calls parseObjectMemberData() to process the object.
-     *
-     * @param member The member name under which the data will be stored.
-     * @param arrayValue The JSON array containing objects to be parsed.
+     * Frees the owned buffers that no value view refers to any more, so that repeated reloads
+     * of owned buffers keep only the text still in use. Section names and keys live in the
+     * string pool and never point into a buffer.
      */
-    void EasyJsonCPP::parseArrayMemberData(const std::string &member, const Json::Value &arrayValue)
+    void EasyJsonCPP::releaseUnusedBuffers()
     {
-        for (const auto &object : arrayValue)
+        // Buffers sorted by address: each view is matched with one binary search.
+        std::vector<std::pair<const char *, std::list<std::string>::iterator>> buffers;
+        for (auto it = _ownedBuffers.begin(); it != _ownedBuffers.end(); ++it)
         {
-            if (!object.isObject())
+            buffers.emplace_back(it->data(), it);
+        }
+        std::sort(buffers.begin(), buffers.end(), [](const auto &a, const auto &b)
+                  { return std::less<const char *>()(a.first, b.first); });
+
+        std::vector<bool> used(buffers.size(), false);
+        for (const auto &section : this->_viewMap)
+        {
+            for (const auto &entry : section.second)
             {
-                throw std::runtime_error("Invalid format for object in configuration file.");
+                const char *value = entry.second.data();
+                auto it = std::upper_bound(buffers.begin(), buffers.end(), value, [](const char *data, const auto &buffer)
+                                           { return std::less<const char *>()(data, buffer.first); });
+                if (it == buffers.begin())
+                {
+                    continue;
+                }
+                --it;
+                // Empty values may point one past the end of their buffer.
+                if (!std::less<const char *>()(it->first + it->second->size(), value))
+                {
+                    used[static_cast<std::size_t>(it - buffers.begin())] = true;
+                }
             }
-
-            parseObjectMemberData(member, object);
         }
-    }
-
-    /** @brief
-     * Parses data for a member of type object in the configuration file.
-     * It iterates over the keys and values of the objectValue,
-     * calling `processMemberData()` for each key-value pair.
-     * @param member The member name under which the data will be stored.
-     * @param objectValue The JSON object containing key-value pairs to be parsed.
-     */
-    void EasyJsonCPP::parseObjectMemberData(const std::string &member, const Json::Value &objectValue)
-    {
 
-        if (objectValue.isObject())
+        for (std::size_t i = 0; i < buffers.size(); ++i)
         {
-            for (const auto &key : objectValue.getMemberNames())
+            if (!used[i])
             {
-                const auto &value = objectValue[key];
-                processMemberData(member, key, value);
+                _ownedBuffers.erase(buffers[i].second);
             }
         }
-        else
+    }
+
+    void EasyJsonCPP::clearBufferStore()
+    {
+        this->_viewMap.clear();
+        _ownedBuffers.clear();
+    }
+
+    std::size_t EasyJsonCPP::ownedBufferBytes() const
+    {
+        std::size_t bytes = 0;
+        for (const auto &buffer : _ownedBuffers)
         {
-            throw std::runtime_error("Invalid format for object in configuration file.");
+            bytes += buffer.size();
         }
+        return bytes;
     }
 
-    /**
-     *  @brief data for a member in the configuration file.
-     * If the section value is a string or an integer, it stores it in the main map
-     *  under the given member and section name.
-     * If the section value is neither a string nor an integer, it throws a runtime_error.
-     * @param member The member name under which the data will be stored.
-     * @param sectionName The name of the section within the member.
-     * @param sectionValue The value associated with the section.
+    /** @brief
+     * Same as loadFromBuffer(), but takes ownership of the text so the views stay valid
+     * for the lifetime of this object. Buffers whose values have all been overridden by later
+     * loads are released.
+     *
+     * @param buffer The JSON text.
+     * @return The map of views containing the parsed configuration data.
+     * @throw std::runtime_error If there's an error processing the buffer.
      */
-    void EasyJsonCPP::processMemberData(const std::string &member,
-                                        const std::string &sectionName,
-                                        const Json::Value &sectionValue)
+    const std::unordered_map<std::string_view, std::unordered_map<std::string_view, std::string_view>> &
+    EasyJsonCPP::loadFromOwnedBuffer(std::string buffer)
     {
-        if (sectionValue.isString() || sectionValue.isInt())
+        // A list never relocates its elements, so views into earlier buffers stay valid.
+        _ownedBuffers.push_back(std::move(buffer));
+        try
         {
-            this->_mainMap[member][sectionName] = sectionValue.asString();
+            return loadFromBuffer(_ownedBuffers.back());
         }
-        else
+        catch (...)
         {
-            throw std::runtime_error("Invalid format for object value in configuration file.");
+            _ownedBuffers.pop_back();
+            throw;
         }
     }
 
-    /**
-     * Retrieves the value associated with the provided key from the given configuration map.
-     * If the key is found, returns a reference to the corresponding value.
-     * If the key is not found, logs an error message and returns a reference to a static error string.
+    /** @brief
+     * Retrieves a value loaded with loadFromBuffer() or loadFromOwnedBuffer().
+     * If the key is not found, logs an error message and returns an empty view.
+     *
+     * @param member The member (section) name.
+     * @param key The key within the member.
+     * @return A view of the value.
+     */
+    std::string_view EasyJsonCPP::getFromBuffer(std::string_view member, std::string_view key) const
+    {
+        const auto memberIt = _viewMap.find(member);
+        if (memberIt != _viewMap.end())
+        {
+            const auto keyIt = memberIt->second.find(key);
+            if (keyIt != memberIt->second.end())
+            {
+                return keyIt->second;
+            }
+        }
+
+        _logger->error("Error retrieving key: {} from config buffer.", key);
+        return {};
+    }
+
+    /** @brief
+     * Returns the text of a scalar value as a view into the buffer being loaded when possible.
+     * jsoncpp records where each value starts and ends in the input, so a string without
+     * escapes is the raw token minus its quotes, and an integer is its raw token as long as
+     * it reads the same as asString(). Other values are decoded into the string pool.
+     *
+     * @param value A string or integer value parsed from _source.
+     * @return A view of the value's text.
+     */
+    std::string_view EasyJsonCPP::sourceView(const Json::Value &value)
+    {
+        const auto start = static_cast<std::size_t>(value.getOffsetStart());
+        const auto limit = static_cast<std::size_t>(value.getOffsetLimit());
+
+        if (start < limit && limit <= _source.size())
+        {
+            std::string_view raw = _source.substr(start, limit - start);
+            if (value.isString())
+            {
+                if (raw.size() >= 2 && raw.front() == '"' && raw.back() == '"' &&
+                    raw.find('\\') == std::string_view::npos)
+                {
+                    return raw.substr(1, raw.size() - 2);
+                }
+            }
+            else if (raw == value.asString())
+            {
+                return raw;
+            }
+        }
+
+        return _stringPool.view(_stringPool.intern(value.asString()));
+    }
+
+    /** @brief
+     * Parses and validates JSON text without throwing, with the same parser as parseDocument().
+     * A syntax error is always reported alone, since nothing can be checked past it.
+     *
+     * @param content The raw JSON text.
+     * @param collectAll Report every structural error instead of stopping at the first one.
+     * @param root Receives the parsed document.
+     * @return The validation result; ok() when the text is a valid configuration.
+     */
+    ValidationResult EasyJsonCPP::validateDocument(std::string_view content, bool collectAll, Json::Value &root)
+    {
+        ValidationResult result;
+        content = withoutBom(content);
+
+        std::string errors;
+        if (!parseJson(content, root, errors))
+        {
+            ValidationError error{ErrorCode::SyntaxError, 0, 0, "$", errors};
+
+            // The CharReader does not expose error offsets; the older reader, run only once the
+            // document is known to be invalid, locates the error.
+            Json::Reader reader;
+            Json::Value ignored;
+            if (!reader.parse(content.data(), content.data() + content.size(), ignored, false))
+            {
+                const auto structured = reader.getStructuredErrors();
+                if (!structured.empty())
+                {
+                    error.message = structured.front().message;
+                    DocumentValidator(content, false, result).locate(static_cast<std::size_t>(structured.front().offset_start), error);
+                }
+            }
+            result.errors.push_back(std::move(error));
+            return result;
+        }
+
+        DocumentValidator(content, collectAll, result).root(root);
+        return result;
+    }
+
+    /** @brief
+     * Validates configuration text with the same rules as loadConfiguration(), without throwing.
+     *
+     * @param content The raw JSON text.
+     * @param collectAll Report every structural error instead of stopping at the first one.
+     * @return The validation result with line, column, JSON path and code of each error.
+     */
+    ValidationResult EasyJsonCPP::validate(std::string_view content, bool collectAll)
+    {
+        Json::Value root;
+        return validateDocument(content, collectAll, root);
+    }
+
+    /** @brief
+     * Validates a configuration file without throwing. See validate().
+     *
+     * @param path The configuration file.
+     * @param collectAll Report every structural error instead of stopping at the first one.
+     * @return The validation result; a FileError if the file cannot be read or decompressed.
+     */
+    ValidationResult EasyJsonCPP::validateFile(const std::string &path, bool collectAll)
+    {
+        std::string content;
+        try
+        {
+            content = detail::readConfigFile(path);
+        }
+        catch (const std::exception &e)
+        {
+            ValidationResult result;
+            result.errors.push_back({ErrorCode::FileError, 0, 0, "$", e.what()});
+            return result;
+        }
+
+        return validate(content, collectAll);
+    }
+
+    /** @brief
+     * Non-throwing counterpart of loadConfiguration(). The file is validated first;
+     * the main map is only updated when the whole document is valid.
+     *
+     * @param collectAll Report every structural error instead of stopping at the first one.
+     * @return The validation result; on success the data is available in the active store
+     *         (_mainMap, or the interned store when interning is enabled).
+     */
+    ValidationResult EasyJsonCPP::tryLoadConfiguration(bool collectAll)
+    {
+        ValidationResult result;
+        std::string content;
+        try
+        {
+            if (_configFile.empty())
+            {
+                throw std::runtime_error("Could not open config file: " + _configFile);
+            }
+            content = detail::readConfigFile(_configFile);
+        }
+        catch (const std::exception &e)
+        {
+            result.errors.push_back({ErrorCode::FileError, 0, 0, "$", e.what()});
+        }
+
+        if (result.ok())
+        {
+            Json::Value root;
+            result = validateDocument(content, collectAll, root);
+            if (result.ok())
+            {
+                // Cannot fail: the document passed the same rules.
+                validateRootObject(root);
+                if (!_hotKeys.empty())
+                {
+                    applyLayout();
+                }
+            }
+        }
+
+        for (const auto &error : result.errors)
+        {
+            _logger->error("{}:{}:{}: {}: {}", _configFile, error.line, error.column, error.path, error.message);
+        }
+        return result;
+    }
+
+    const char *EasyJsonCPP::errorMessage(ErrorCode code)
+    {
+        switch (code)
+        {
+        case ErrorCode::None:
+            return "No error.";
+        case ErrorCode::FileError:
+            return "Could not open config file.";
+        case ErrorCode::SyntaxError:
+            return "Invalid JSON syntax.";
+        case ErrorCode::InvalidRoot:
+            return "Config file is not an array of Json objects.";
+        case ErrorCode::EmptyRoot:
+            return "Objects in configuration is empty.";
+        case ErrorCode::InvalidObject:
+            return "Invalid format for object in configuration file.";
+        case ErrorCode::EmptyObject:
+            return "Empty object in configuration is empty.";
+        case ErrorCode::InvalidMemberValue:
+        case ErrorCode::InvalidValue:
+            return "Invalid format for object value in configuration file.";
+        }
+        return "Unknown error.";
+    }
+
+    const char *EasyJsonCPP::errorCodeName(ErrorCode code)
+    {
+        switch (code)
+        {
+        case ErrorCode::None:
+            return "none";
+        case ErrorCode::FileError:
+            return "file-error";
+        case ErrorCode::SyntaxError:
+            return "syntax-error";
+        case ErrorCode::InvalidRoot:
+            return "invalid-root";
+        case ErrorCode::EmptyRoot:
+            return "empty-root";
+        case ErrorCode::InvalidObject:
+            return "invalid-object";
+        case ErrorCode::EmptyObject:
+            return "empty-object";
+        case ErrorCode::InvalidMemberValue:
+            return "invalid-member-value";
+        case ErrorCode::InvalidValue:
+            return "invalid-value";
+        }
+        return "unknown";
+    }
+
+    /** @brief
+     * Validates the root object of the configuration file.
+     * It checks whether the root is an array or an object.
+     * If it's an array, it calls parseArrayObjectData() to parse it.
+     * If it's an object, it may perform additional validation or processing in the future.
+     * If it's neither an array nor an object, it throws a runtime_error.
+     *
+     * @param root The root JSON value of the configuration file.
+     */
+    void EasyJsonCPP::validateRootObject(const Json::Value &root)
+    {
+        _logger->debug("Validating configuration file: {}.", this->_configFile);
+        if (root.isArray())
+        {
+            parseArrayObjectData(root);
+        }
+        else if (root.isObject())
+        {
+        } // NOTE: Validate other possible formats of a json file here.
+        else
+        {
+            throw std::runtime_error(errorMessage(ErrorCode::InvalidRoot));
+        }
+    }
+
+    /** @brief
+     * Parses an array of objects from the configuration file rootObjects.
+     * It iterates over each object in the array, verifying that each is indeed an object.
+     * For each object, it iterates over its members and checks whether each member's value is an array or object.
+     * If it's an array, it calls parseArrayMemberData() to process it.
+     * If it's an object, it calls parseObjectMemberData() to process it.
+     * If the value is neither an array nor an object, it throws a runtime_error.
+     *
+     * @param rootObjects The JSON array of objects to be parsed.
+     */
+
+    void EasyJsonCPP::parseArrayObjectData(const Json::Value &rootObjects)
+    {
+        _logger->debug("Parsing configuration file: {}.", this->_configFile);
+
+        // Check objects.
+        if (rootObjects.empty())
+        {
+            throw std::runtime_error(errorMessage(ErrorCode::EmptyRoot));
+        }
+
+        for (const auto &object : rootObjects)
+        {
+            // Check object format
+            if (!object.isObject())
+            {
+                throw std::runtime_error(errorMessage(ErrorCode::InvalidObject));
+            }
+
+            // Check if object is empty.
+            //  TODO: skip over empty objects here.
+            if (object.empty())
+            {
+                throw std::runtime_error(errorMessage(ErrorCode::EmptyObject));
+            }
+
+            // Process object.
+            for (const auto &member : object.getMemberNames())
+            {
+                const auto &key = object[member];
+
+                if (key.isArray())
+                {
+                    this->parseArrayMemberData(member, key);
+                }
+                else if (key.isObject())
+                {
+                    this->parseObjectMemberData(member, key);
+                }
+                else
+                {
+                    throw std::runtime_error(errorMessage(ErrorCode::InvalidMemberValue));
+                }
+            }
+        }
+    }
+
+    /** @brief
+     * Parses data for a member of type array in the configuration file.
+     * It iterates over the elements of the arrayValue, each of which should be an object.
+     * If any element is not an object, it throws a runtime_error.
+     * For each object element, it calls parseObjectMemberData() to process the object.
+     *
+     * @param member The member name under which the data will be stored.
+     * @param arrayValue The JSON array containing objects to be parsed.
+     */
+    void EasyJsonCPP::parseArrayMemberData(const std::string &member, const Json::Value &arrayValue)
+    {
+        for (const auto &object : arrayValue)
+        {
+            if (!object.isObject())
+            {
+                throw std::runtime_error(errorMessage(ErrorCode::InvalidObject));
+            }
+
+            parseObjectMemberData(member, object);
+        }
+    }
+
+    /** @brief
+     * Parses data for a member of type object in the configuration file.
+     * It iterates over the keys and values of the objectValue,
+     * calling `processMemberData()` for each key-value pair.
+     * @param member The member name under which the data will be stored.
+     * @param objectValue The JSON object containing key-value pairs to be parsed.
+     */
+    void EasyJsonCPP::parseObjectMemberData(const std::string &member, const Json::Value &objectValue)
+    {
+
+        if (objectValue.isObject())
+        {
+            for (const auto &key : objectValue.getMemberNames())
+            {
+                const auto &value = objectValue[key];
+                processMemberData(member, key, value);
+            }
+        }
+        else
+        {
+            throw std::runtime_error(errorMessage(ErrorCode::InvalidObject));
+        }
+    }
+
+    /**
+     *  @brief data for a member in the configuration file.
+     * If the section value is a string or an integer, it stores it in the main map
+     *  under the given member and section name.
+     * If the section value is an array of numbers, it is packed into a NumericArray in the array map.
+     * If the section value is none of these, it throws a runtime_error.
+     * When interning is enabled, the member, section name and value are interned and only
+     * their IDs are stored, in the interned map. While loading from a buffer, the value is
+     * stored as a view (see sourceView()) in the view map. Declared value indexes are updated
+     * for values stored in the main map. A key holds one value: a scalar replaces an array
+     * stored under the same key, and the other way round.
+     * @param member The member name under which the data will be stored.
+     * @param sectionName The name of the section within the member.
+     * @param sectionValue The value associated with the section.
+     */
+    void EasyJsonCPP::processMemberData(const std::string &member,
+                                        const std::string &sectionName,
+                                        const Json::Value &sectionValue)
+    {
+        if (sectionValue.isString() || sectionValue.isInt())
+        {
+            // A key holds one value: a scalar replaces an array loaded earlier.
+            if (!_arrayMap.empty())
+            {
+                eraseArray(member, sectionName);
+            }
+
+            if (_bufferMode)
+            {
+                this->_viewMap[_stringPool.view(_stringPool.intern(member))]
+                              [_stringPool.view(_stringPool.intern(sectionName))] = sourceView(sectionValue);
+            }
+            else if (_interning)
+            {
+                StringPool::Id valueId;
+                const char *begin = nullptr;
+                const char *end = nullptr;
+                if (sectionValue.getString(&begin, &end))
+                {
+                    // Intern straight from the parser's buffer, no temporary string.
+                    valueId = _stringPool.intern(std::string_view(begin, static_cast<std::size_t>(end - begin)));
+                }
+                else
+                {
+                    valueId = _stringPool.intern(sectionValue.asString());
+                }
+
+                // Consecutive calls almost always target the same member: skip re-hashing its name.
+                if (_lastMemberId == StringPool::npos || _stringPool.view(_lastMemberId) != member)
+                {
+                    _lastMemberId = _stringPool.intern(member);
+                }
+
+                this->_internedMap[_lastMemberId][_stringPool.intern(sectionName)] = valueId;
+            }
+            else
+            {
+                // Cached copies would go stale; the layout is rebuilt after the load.
+                if (!_hotCache.empty())
+                {
+                    _hotCache.clear();
+                }
+
+                if (_valueIndexes.empty())
+                {
+                    this->_mainMap[member][sectionName] = sectionValue.asString();
+                }
+                else
+                {
+                    auto &section = *this->_mainMap.try_emplace(member).first;
+                    const auto slot = section.second.try_emplace(sectionName);
+                    std::string value = sectionValue.asString();
+
+                    indexValue(section.first, sectionName, slot.second ? nullptr : &slot.first->second, value);
+                    slot.first->second = std::move(value);
+                }
+            }
+        }
+        else if (sectionValue.isArray())
+        {
+            // Converted once here; readers get views of the packed buffer.
+            NumericArray array;
+            try
+            {
+                array = NumericArray::fromJson(sectionValue);
+            }
+            catch (const std::runtime_error &)
+            {
+                throw std::runtime_error(errorMessage(ErrorCode::InvalidValue));
+            }
+            eraseScalar(member, sectionName);
+            this->_arrayMap[member][sectionName] = std::move(array);
+        }
+        else
+        {
+            throw std::runtime_error(errorMessage(ErrorCode::InvalidValue));
+        }
+    }
+
+    /** @brief
+     * Removes a scalar value from the store being loaded (and from the value indexes), when
+     * an array replaces it.
+     *
+     * @param member The member (section) name.
+     * @param key The key within the member.
+     */
+    void EasyJsonCPP::eraseScalar(const std::string &member, const std::string &key)
+    {
+        if (_bufferMode)
+        {
+            const auto section = this->_viewMap.find(member);
+            if (section != this->_viewMap.end())
+            {
+                section->second.erase(key);
+            }
+        }
+        else if (_interning)
+        {
+            const auto section = this->_internedMap.find(_stringPool.find(member));
+            if (section != this->_internedMap.end())
+            {
+                section->second.erase(_stringPool.find(key));
+            }
+        }
+        else
+        {
+            const auto section = this->_mainMap.find(member);
+            if (section == this->_mainMap.end())
+            {
+                return;
+            }
+            const auto entry = section->second.find(key);
+            if (entry == section->second.end())
+            {
+                return;
+            }
+
+            const auto index = _valueIndexes.find(key);
+            if (index != _valueIndexes.end())
+            {
+                index->second.erase(entry->second, section->first);
+            }
+            section->second.erase(entry);
+            if (section->second.empty())
+            {
+                this->_mainMap.erase(section);
+            }
+            _hotCache.clear();
+        }
+    }
+
+    /** @brief
+     * Removes a numeric array, when a scalar value replaces it.
+     *
+     * @param member The member (section) name.
+     * @param key The key within the member.
+     */
+    void EasyJsonCPP::eraseArray(const std::string &member, const std::string &key)
+    {
+        const auto section = this->_arrayMap.find(member);
+        if (section != this->_arrayMap.end())
+        {
+            section->second.erase(key);
+            if (section->second.empty())
+            {
+                this->_arrayMap.erase(section);
+            }
+        }
+    }
+
+    /**
+     * Retrieves the value associated with the provided key from the given configuration map.
+     * If the key is found, returns a reference to the corresponding value.
+     * If the key is not found, logs an error message and returns a reference to a static error string.
      *
      * @param key The key whose associated value is to be retrieved.
      * @param configMap The configuration map to search for the key.
@@ -251,6 +1155,415 @@ namespace easyjson
         return errorString;
     }
 
+    /** @brief
+     * Loads the configuration file into the interned store (see setInterning()).
+     * Values are then read with getInterned() or compared with getInternedId().
+     *
+     * @return The number of interned entries (member/key pairs).
+     * @throw std::runtime_error If there's an error processing the configuration file.
+     */
+    std::size_t EasyJsonCPP::loadInterned()
+    {
+        if (_configFile.empty())
+        {
+            const std::string &errorMsg = _configFile + ": file is empty";
+            _logger->error(errorMsg);
+            throw std::runtime_error(errorMsg);
+        }
+
+        _logger->debug("Loading configuration file into the string pool: {}", _configFile);
+
+        const bool interning = _interning;
+        _interning = true;
+        try
+        {
+            parseDocument(detail::readConfigFile(_configFile));
+        }
+        catch (const std::exception &e)
+        {
+            _interning = interning;
+            std::string error_msg = "Error processing configuration file: " + std::string(e.what());
+            _logger->error(error_msg);
+            throw std::runtime_error(error_msg);
+        }
+        _interning = interning;
+
+        std::size_t entries = 0;
+        for (const auto &member : _internedMap)
+        {
+            entries += member.second.size();
+        }
+        return entries;
+    }
+
+    /** @brief
+     * Retrieves the ID of the interned value stored under the given member and key.
+     * Two values are equal exactly when their IDs are equal.
+     *
+     * @param member The member (section) name.
+     * @param key The key within the member.
+     * @return The value ID, or StringPool::npos if the member or key does not exist.
+     */
+    StringPool::Id EasyJsonCPP::getInternedId(std::string_view member, std::string_view key) const
+    {
+        const auto memberIt = _internedMap.find(_stringPool.find(member));
+        if (memberIt == _internedMap.end())
+        {
+            return StringPool::npos;
+        }
+
+        const auto keyIt = memberIt->second.find(_stringPool.find(key));
+        return keyIt == memberIt->second.end() ? StringPool::npos : keyIt->second;
+    }
+
+    /** @brief
+     * Retrieves the interned value stored under the given member and key.
+     * If the key is not found, logs an error message and returns an empty view.
+     *
+     * @param member The member (section) name.
+     * @param key The key within the member.
+     * @return A view into the string pool, valid for the lifetime of this object.
+     */
+    std::string_view EasyJsonCPP::getInterned(std::string_view member, std::string_view key) const
+    {
+        const StringPool::Id id = getInternedId(member, key);
+        if (id == StringPool::npos)
+        {
+            _logger->error("Error retrieving key: {} from config file.", key);
+            return {};
+        }
+
+        return _stringPool.view(id);
+    }
+
+    /** @brief
+     * Declares a secondary index on a key: for each value of that key, the sections holding it.
+     * Sections already loaded are indexed immediately; later loads keep the index up to date.
+     * Only data stored in the main map is indexed (not the interned or buffer stores).
+     *
+     * @param key The key to index, e.g. "Action" or "app_id".
+     */
+    void EasyJsonCPP::addIndex(const std::string &key)
+    {
+        const auto created = _valueIndexes.try_emplace(key);
+        if (!created.second)
+        {
+            return;
+        }
+
+        auto &index = created.first->second;
+        for (const auto &section : _mainMap)
+        {
+            const auto value = section.second.find(key);
+            if (value != section.second.end())
+            {
+                index.insert(value->second, section.first);
+            }
+        }
+    }
+
+    void EasyJsonCPP::ValueIndex::insert(const std::string &value, std::string_view member)
+    {
+        auto &list = sections[value];
+        positions[member] = list.size();
+        list.push_back(member);
+    }
+
+    /** @brief
+     * Removes a section from the list of a value in O(1): the last section of the list takes
+     * its slot, so the order within a list is not preserved.
+     */
+    void EasyJsonCPP::ValueIndex::erase(const std::string &value, std::string_view member)
+    {
+        const auto listIt = sections.find(value);
+        const auto positionIt = positions.find(member);
+        if (listIt == sections.end() || positionIt == positions.end())
+        {
+            return;
+        }
+
+        auto &list = listIt->second;
+        const std::size_t position = positionIt->second;
+        if (position + 1 != list.size())
+        {
+            list[position] = list.back();
+            positions[list[position]] = position;
+        }
+        list.pop_back();
+        positions.erase(positionIt);
+
+        if (list.empty())
+        {
+            sections.erase(listIt);
+        }
+    }
+
+    /** @brief
+     * Moves a section from the list of its previous value to the list of its new value.
+     * Unchanged values are left alone, so reloading an identical file costs one comparison per key.
+     *
+     * @param member The section name, owned by _mainMap so the stored view stays valid.
+     * @param key The key being stored.
+     * @param previous The value being replaced, or null for a new key.
+     * @param value The new value.
+     */
+    void EasyJsonCPP::indexValue(const std::string &member, const std::string &key,
+                                 const std::string *previous, const std::string &value)
+    {
+        const auto indexIt = _valueIndexes.find(key);
+        if (indexIt == _valueIndexes.end())
+        {
+            return;
+        }
+
+        auto &index = indexIt->second;
+        if (previous)
+        {
+            if (*previous == value)
+            {
+                return;
+            }
+
+            index.erase(*previous, member);
+        }
+
+        index.insert(value, member);
+    }
+
+    /** @brief
+     * Reverse lookup through a declared index.
+     *
+     * @param key An indexed key.
+     * @param value The value to look for.
+     * @return The names of the sections whose key holds this value (empty if none).
+     * @throw std::runtime_error If no index was declared for the key.
+     */
+    const std::vector<std::string_view> &EasyJsonCPP::findSections(const std::string &key, const std::string &value) const
+    {
+        static const std::vector<std::string_view> none;
+
+        const auto indexIt = _valueIndexes.find(key);
+        if (indexIt == _valueIndexes.end())
+        {
+            _logger->error("No index declared for key: {}", key);
+            throw std::runtime_error("No index declared for key: " + key);
+        }
+
+        const auto valueIt = indexIt->second.sections.find(value);
+        return valueIt == indexIt->second.sections.end() ? none : valueIt->second;
+    }
+
+    /** @brief
+     * Finds a numeric array value.
+     *
+     * @param member The section name.
+     * @param key The key within the section.
+     * @return The packed array, or null if the section has no array under this key.
+     */
+    const NumericArray *EasyJsonCPP::findArray(const std::string &member, const std::string &key) const
+    {
+        const auto sectionIt = _arrayMap.find(member);
+        if (sectionIt == _arrayMap.end())
+        {
+            return nullptr;
+        }
+
+        const auto arrayIt = sectionIt->second.find(key);
+        return arrayIt == sectionIt->second.end() ? nullptr : &arrayIt->second;
+    }
+
+    /** @brief
+     * Returns a view of an integer array. The view stays valid until the next load.
+     *
+     * @throw std::runtime_error If there is no such array or it holds doubles.
+     */
+    ArrayView<std::int64_t> EasyJsonCPP::getInt64Array(const std::string &member, const std::string &key) const
+    {
+        const NumericArray *array = findArray(member, key);
+        if (!array || array->type() != NumericArray::Type::Int64)
+        {
+            _logger->error("No int64 array at {}.{}", member, key);
+            throw std::runtime_error("No int64 array at " + member + "." + key);
+        }
+        return array->int64s();
+    }
+
+    /** @brief
+     * Returns a view of a real-number array. The view stays valid until the next load.
+     *
+     * @throw std::runtime_error If there is no such array or it only holds integers.
+     */
+    ArrayView<double> EasyJsonCPP::getDoubleArray(const std::string &member, const std::string &key) const
+    {
+        const NumericArray *array = findArray(member, key);
+        if (!array || array->type() != NumericArray::Type::Double)
+        {
+            _logger->error("No double array at {}.{}", member, key);
+            throw std::runtime_error("No double array at " + member + "." + key);
+        }
+        return array->doubles();
+    }
+
+    /** @brief
+     * Reverse lookup by scanning every section of the main map; works for any key.
+     *
+     * @param key The key to look at.
+     * @param value The value to look for.
+     * @return The names of the sections whose key holds this value.
+     */
+    std::vector<std::string_view> EasyJsonCPP::scanSections(const std::string &key, const std::string &value) const
+    {
+        std::vector<std::string_view> sections;
+        for (const auto &section : _mainMap)
+        {
+            const auto found = section.second.find(key);
+            if (found != section.second.end() && found->second == value)
+            {
+                sections.push_back(section.first);
+            }
+        }
+        return sections;
+    }
+
+    /** @brief
+     * Approximate heap footprint of the declared value indexes: hash nodes and buckets,
+     * value strings that do not fit the small-string buffer, and the section lists.
+     */
+    std::size_t EasyJsonCPP::indexMemoryUsage() const
+    {
+        const auto stringHeap = [](const std::string &text)
+        {
+            return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+        };
+        // Node: the pair, a next pointer and the cached hash.
+        const std::size_t nodeOverhead = 2 * sizeof(void *);
+
+        std::size_t bytes = _valueIndexes.bucket_count() * sizeof(void *);
+        for (const auto &index : _valueIndexes)
+        {
+            bytes += sizeof(index) + nodeOverhead + stringHeap(index.first);
+            bytes += index.second.sections.bucket_count() * sizeof(void *);
+            for (const auto &entry : index.second.sections)
+            {
+                bytes += sizeof(entry) + nodeOverhead + stringHeap(entry.first);
+                bytes += entry.second.capacity() * sizeof(std::string_view);
+            }
+            bytes += index.second.positions.bucket_count() * sizeof(void *);
+            bytes += index.second.positions.size() *
+                     (sizeof(std::pair<const std::string_view, std::size_t>) + nodeOverhead);
+        }
+        return bytes;
+    }
+
+    /** @brief
+     * Retrieves a value from the main map, recording the access when profiling is enabled.
+     * Hot entries laid out by optimizeLayout() are served from the compact hot-key cache.
+     * If the key is not found, logs an error message and returns an empty view.
+     *
+     * @param member The member (section) name.
+     * @param key The key within the member.
+     * @return A view of the value, valid until the next load.
+     */
+    std::string_view EasyJsonCPP::lookup(const std::string &member, const std::string &key) const
+    {
+        KeyProfiler::instance().record(member, key);
+
+        std::string_view value;
+        if (_hotCache.find(member, key, value))
+        {
+            return value;
+        }
+
+        const auto memberIt = _mainMap.find(member);
+        if (memberIt != _mainMap.end())
+        {
+            const auto keyIt = memberIt->second.find(key);
+            if (keyIt != memberIt->second.end())
+            {
+                return keyIt->second;
+            }
+        }
+
+        _logger->error("Error retrieving key: {} from config file.", key);
+        return {};
+    }
+
+    /** @brief
+     * Lays out the hottest keys reported so far by the profiler. See the overload below.
+     *
+     * @param maxKeys Maximum number of entries to pack.
+     */
+    void EasyJsonCPP::optimizeLayout(std::size_t maxKeys)
+    {
+        optimizeLayout(KeyProfiler::instance().report(), maxKeys);
+    }
+
+    /** @brief
+     * Copies the hottest main-map entries into the hot-key cache, hottest first, so that a
+     * request path reading a small hot set touches a handful of cache lines instead of
+     * scattered hash nodes. Keys that are not in the main map are skipped. The list is kept
+     * and laid out again after every subsequent load.
+     *
+     * @param hotKeys Hot keys, hottest first (from KeyProfiler::report() or KeyProfiler::load()).
+     * @param maxKeys Maximum number of entries to pack.
+     */
+    void EasyJsonCPP::optimizeLayout(const std::vector<HotKey> &hotKeys, std::size_t maxKeys)
+    {
+        _hotKeys = hotKeys;
+        _hotKeyLimit = maxKeys;
+        applyLayout();
+    }
+
+    /** @brief
+     * Builds the hot-key cache from the remembered hot keys (see optimizeLayout()).
+     */
+    void EasyJsonCPP::applyLayout()
+    {
+        std::vector<HotKey> selected;
+        for (const auto &hotKey : _hotKeys)
+        {
+            if (selected.size() == _hotKeyLimit)
+            {
+                break;
+            }
+            const auto memberIt = _mainMap.find(hotKey.section);
+            if (memberIt != _mainMap.end() && memberIt->second.count(hotKey.key))
+            {
+                selected.push_back(hotKey);
+            }
+        }
+
+        _hotCache.build(selected, [this](const std::string &member, const std::string &key)
+                        { return &_mainMap.at(member).at(key); });
+        _logger->debug("Hot-key layout: {} entries in {} bytes.", _hotCache.size(), _hotCache.footprint());
+    }
+
+    /** @brief
+     * Saves the profiler's current hot-key report.
+     *
+     * @param path The profile file to write.
+     * @param top Number of hottest keys to keep.
+     */
+    void EasyJsonCPP::saveProfile(const std::string &path, std::size_t top) const
+    {
+        KeyProfiler::save(path, KeyProfiler::instance().report(top));
+    }
+
+    /** @brief
+     * Loads a saved hot-key report. Its layout is applied now if data is already loaded,
+     * and again after every subsequent load.
+     *
+     * @param path The profile file written by saveProfile().
+     */
+    void EasyJsonCPP::loadProfile(const std::string &path)
+    {
+        _hotKeys = KeyProfiler::load(path);
+        if (!_mainMap.empty())
+        {
+            applyLayout();
+        }
+    }
+
     /** @brief
      * Sets the log level of the application based on the provided level string.
      * Valid log levels include 'debug', 'info', 'warn', 'error', 'critical', and 'off'.
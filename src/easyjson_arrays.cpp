@@ -0,0 +1,140 @@
+#include "easyjson_arrays.h"
+
+namespace easyjson
+{
+    namespace
+    {
+        bool isElement(const Json::Value &element)
+        {
+            switch (element.type())
+            {
+            case Json::intValue:
+            case Json::realValue:
+                return true;
+            case Json::uintValue:
+                return element.isInt64();
+            default:
+                return false;
+            }
+        }
+    } // ! anonymous namespace
+
+    NumericArray::NumericArray(const NumericArray &other)
+    {
+        *this = other;
+    }
+
+    NumericArray &NumericArray::operator=(const NumericArray &other)
+    {
+        if (this != &other)
+        {
+            _type = other._type;
+            _size = other._size;
+            allocate();
+            std::memcpy(_data.get(), other._data.get(), _size * sizeof(double));
+        }
+        return *this;
+    }
+
+    NumericArray::NumericArray(NumericArray &&other) noexcept
+        : _type(other._type), _size(std::exchange(other._size, 0)), _data(std::move(other._data))
+    {
+    }
+
+    NumericArray &NumericArray::operator=(NumericArray &&other) noexcept
+    {
+        if (this != &other)
+        {
+            _type = other._type;
+            _size = std::exchange(other._size, 0);
+            _data = std::move(other._data);
+        }
+        return *this;
+    }
+
+    void NumericArray::allocate()
+    {
+        // Padded to whole cache lines so vector loops may read a full last block.
+        static_assert(sizeof(std::int64_t) == sizeof(double), "Both element types share one layout.");
+        const std::size_t bytes = (std::max<std::size_t>(_size * sizeof(double), 1) + kAlignment - 1) /
+                                  kAlignment * kAlignment;
+        _data.reset(std::aligned_alloc(kAlignment, bytes));
+        if (!_data)
+        {
+            throw std::bad_alloc();
+        }
+        std::memset(_data.get(), 0, bytes);
+    }
+
+    bool NumericArray::isNumeric(const Json::Value &value)
+    {
+        return value.isArray() && std::all_of(value.begin(), value.end(), isElement);
+    }
+
+    /** @brief
+     * Converts a JSON array of numbers into one packed buffer. The array is stored as int64 when
+     * every element is an integer, and as double when at least one element is a real number.
+     *
+     * @param value The JSON array.
+     * @return The packed array.
+     * @throw std::runtime_error If an element is not a number or an integer does not fit in int64.
+     */
+    NumericArray NumericArray::fromJson(const Json::Value &value)
+    {
+        // One pass to check the elements and pick the type, one pass to convert.
+        bool numeric = value.isArray();
+        bool real = false;
+        for (auto it = value.begin(); numeric && it != value.end(); ++it)
+        {
+            numeric = isElement(*it);
+            real = real || it->type() == Json::realValue;
+        }
+        if (!numeric)
+        {
+            throw std::runtime_error("Invalid numeric array: elements must all be numbers within int64 range");
+        }
+
+        NumericArray array;
+        array._size = value.size();
+        array._type = real ? Type::Double : Type::Int64;
+        array.allocate();
+
+        // Iterators, not operator[]: jsoncpp keeps array elements in a map.
+        std::size_t index = 0;
+        if (array._type == Type::Int64)
+        {
+            auto *data = static_cast<std::int64_t *>(array._data.get());
+            for (const auto &element : value)
+            {
+                data[index++] = element.asInt64();
+            }
+        }
+        else
+        {
+            auto *data = static_cast<double *>(array._data.get());
+            for (const auto &element : value)
+            {
+                data[index++] = element.asDouble();
+            }
+        }
+        return array;
+    }
+
+    ArrayView<std::int64_t> NumericArray::int64s() const
+    {
+        if (_type != Type::Int64)
+        {
+            throw std::runtime_error("Numeric array holds doubles, not int64 values");
+        }
+        return {static_cast<const std::int64_t *>(_data.get()), _size};
+    }
+
+    ArrayView<double> NumericArray::doubles() const
+    {
+        if (_type != Type::Double)
+        {
+            throw std::runtime_error("Numeric array holds int64 values, not doubles");
+        }
+        return {static_cast<const double *>(_data.get()), _size};
+    }
+} // ! EasyJson namespace
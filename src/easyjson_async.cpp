@@ -0,0 +1,574 @@
+#include "easyjson_async.h"
+
+#include <unordered_set>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define EASYJSON_HAVE_IO_URING 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+#endif
+
+namespace easyjson
+{
+    namespace detail
+    {
+        namespace
+        {
+            /** @brief
+             * Blocking read of the whole file, used by the pool fallback.
+             * @throw std::runtime_error If the file cannot be opened.
+             */
+            std::string readFileBlocking(const std::string &path)
+            {
+                std::ifstream file(path, std::ios::in | std::ios::binary);
+                if (!file.is_open())
+                {
+                    throw std::runtime_error("Could not open config file: " + path);
+                }
+
+                std::ostringstream content;
+                content << file.rdbuf();
+                return content.str();
+            }
+
+            /// Off when EASYJSON_DISABLE_IO_URING is set; see setIoUringEnabled().
+            std::atomic<bool> uringEnabled{std::getenv("EASYJSON_DISABLE_IO_URING") == nullptr};
+
+            void readFileOnPool(const std::string &path, ReadCallback callback)
+            {
+                ThreadPool::instance().post([path, callback = std::move(callback)]()
+                                            {
+                    std::string content;
+                    try
+                    {
+                        content = readFileBlocking(path);
+                    }
+                    catch (...)
+                    {
+                        callback({}, std::current_exception());
+                        return;
+                    }
+                    callback(std::move(content), nullptr); });
+            }
+
+#ifdef EASYJSON_HAVE_IO_URING
+            /// One in-flight file read; resubmitted until the whole file is read.
+            struct ReadRequest
+            {
+                int fd{-1};
+                std::string path;
+                std::string buffer;
+                std::size_t offset{0};
+                struct iovec iov
+                {
+                };
+                ReadCallback callback;
+            };
+
+            /** @brief
+             * Minimal io_uring driver shared by all asynchronous loads.
+             * Submissions happen on the calling thread; a single reaper thread waits for
+             * completions, resubmits short reads and hands finished buffers to the callback.
+             */
+            class UringReader
+            {
+            public:
+                static UringReader *instance()
+                {
+                    static std::unique_ptr<UringReader> reader = create();
+                    return reader.get();
+                }
+
+                /// Returns the request back when the ring is broken, so the caller can read it on the pool.
+                std::unique_ptr<ReadRequest> submit(std::unique_ptr<ReadRequest> request)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _slots.wait(lock, [this]
+                                { return _broken || _inFlight < _entries; });
+                    if (_broken)
+                    {
+                        return request;
+                    }
+
+                    ++_inFlight;
+                    ReadRequest *raw = request.release();
+                    _pending.insert(raw);
+                    if (!pushRead(lock, raw))
+                    {
+                        const int error = errno;
+                        _pending.erase(raw);
+                        --_inFlight;
+                        lock.unlock();
+                        _slots.notify_one();
+                        fail(raw, error);
+                    }
+                    return nullptr;
+                }
+
+                bool broken() const { return _broken; }
+
+                ~UringReader()
+                {
+                    if (_ringFd < 0)
+                    {
+                        return;
+                    }
+
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (!_broken)
+                        {
+                            pushSqe(lock, IORING_OP_NOP, -1, nullptr, 0, 0);
+                        }
+                    }
+                    if (_reaper.joinable())
+                    {
+                        _reaper.join();
+                    }
+                    unmap();
+                    close(_ringFd);
+                }
+
+            private:
+                static constexpr unsigned kEntries = 64;
+
+                static std::unique_ptr<UringReader> create()
+                {
+                    // Make sure the pool outlives the reaper thread, which posts to it.
+                    ThreadPool::instance();
+
+                    std::unique_ptr<UringReader> reader(new UringReader());
+                    if (!reader->setup(kEntries))
+                    {
+                        return nullptr;
+                    }
+                    reader->_reaper = std::thread(&UringReader::reap, reader.get());
+                    return reader;
+                }
+
+                UringReader() = default;
+
+                bool setup(unsigned entries)
+                {
+                    struct io_uring_params params;
+                    std::memset(&params, 0, sizeof(params));
+
+                    _ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+                    if (_ringFd < 0)
+                    {
+                        return false;
+                    }
+
+                    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+                    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+                    if (singleMmap)
+                    {
+                        _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+                    }
+
+                    _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQ_RING);
+                    if (_sqRing == MAP_FAILED)
+                    {
+                        _sqRing = nullptr;
+                        close(_ringFd);
+                        _ringFd = -1;
+                        return false;
+                    }
+
+                    _cqRing = singleMmap ? _sqRing
+                                         : mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE,
+                                                MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_CQ_RING);
+                    _sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+                    void *sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQES);
+                    if (_cqRing == MAP_FAILED || sqes == MAP_FAILED)
+                    {
+                        _cqRing = _cqRing == MAP_FAILED ? nullptr : _cqRing;
+                        _sqes = sqes == MAP_FAILED ? nullptr : static_cast<struct io_uring_sqe *>(sqes);
+                        unmap();
+                        close(_ringFd);
+                        _ringFd = -1;
+                        return false;
+                    }
+                    _sqes = static_cast<struct io_uring_sqe *>(sqes);
+
+                    auto *sq = static_cast<char *>(_sqRing);
+                    _sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+                    _sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+                    _sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+                    _sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+                    auto *cq = static_cast<char *>(_cqRing);
+                    _cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+                    _cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+                    _cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+                    _cqes = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+
+                    // Never have more reads in flight than the submission queue can hold.
+                    _entries = params.sq_entries;
+                    return true;
+                }
+
+                void unmap()
+                {
+                    if (_sqes)
+                    {
+                        munmap(_sqes, _sqesSize);
+                    }
+                    if (_cqRing && _cqRing != _sqRing)
+                    {
+                        munmap(_cqRing, _cqRingSize);
+                    }
+                    if (_sqRing)
+                    {
+                        munmap(_sqRing, _sqRingSize);
+                    }
+                }
+
+                /** @brief
+                 * Queues one SQE and enters the kernel. Must be called with the lock on _mutex held.
+                 * On EAGAIN or EBUSY (the kernel is short of resources, or completions wait to be
+                 * reaped) the entry stays queued, since any later enter submits every queued entry.
+                 * Submitters back off with the lock released so the reaper can drain completions;
+                 * the reaper itself returns at once and submits the entry with its next wait.
+                 */
+                bool pushSqe(std::unique_lock<std::mutex> &lock, unsigned char opcode, int fd, const void *addr,
+                             unsigned len, std::uint64_t offset, std::uint64_t userData = 0)
+                {
+                    const unsigned tail = *_sqTail;
+                    const unsigned index = tail & _sqMask;
+
+                    struct io_uring_sqe *sqe = &_sqes[index];
+                    std::memset(sqe, 0, sizeof(*sqe));
+                    sqe->opcode = opcode;
+                    sqe->fd = fd;
+                    sqe->addr = reinterpret_cast<std::uint64_t>(addr);
+                    sqe->len = len;
+                    sqe->off = offset;
+                    sqe->user_data = userData;
+
+                    _sqArray[index] = index;
+                    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+                    auto backoff = std::chrono::microseconds(10);
+                    for (;;)
+                    {
+                        // Another submitter may have entered the kernel with our entry while we slept.
+                        const unsigned queued = *_sqTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+                        if (queued == 0)
+                        {
+                            return true;
+                        }
+
+                        const long submitted = syscall(__NR_io_uring_enter, _ringFd, queued, 0, 0, nullptr, 0);
+                        if (submitted >= 0)
+                        {
+                            return true;
+                        }
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        if (errno == EAGAIN || errno == EBUSY)
+                        {
+                            if (std::this_thread::get_id() == _reaper.get_id())
+                            {
+                                return true;
+                            }
+                            lock.unlock();
+                            std::this_thread::sleep_for(backoff);
+                            backoff = std::min<std::chrono::microseconds>(backoff * 2, std::chrono::milliseconds(1));
+                            lock.lock();
+                            continue;
+                        }
+
+                        // The kernel did not consume the entry: take it back, unless later
+                        // entries were queued behind it, in which case it goes with them.
+                        if (*_sqTail == tail + 1 && static_cast<int>(tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE)) >= 0)
+                        {
+                            __atomic_store_n(_sqTail, tail, __ATOMIC_RELEASE);
+                            return false;
+                        }
+                        return true;
+                    }
+                }
+
+                bool pushRead(std::unique_lock<std::mutex> &lock, ReadRequest *request)
+                {
+                    request->iov.iov_base = &request->buffer[request->offset];
+                    request->iov.iov_len = request->buffer.size() - request->offset;
+                    return pushSqe(lock, IORING_OP_READV, request->fd, &request->iov, 1, request->offset,
+                                   reinterpret_cast<std::uint64_t>(request));
+                }
+
+                static void finish(ReadRequest *request)
+                {
+                    std::unique_ptr<ReadRequest> owned(request);
+                    close(owned->fd);
+                    owned->callback(std::move(owned->buffer), nullptr);
+                }
+
+                static void fail(ReadRequest *request, int error)
+                {
+                    std::unique_ptr<ReadRequest> owned(request);
+                    close(owned->fd);
+                    owned->callback({}, std::make_exception_ptr(std::runtime_error(
+                                            "Could not read config file: " + owned->path + ": " + std::strerror(error))));
+                }
+
+                /** @brief
+                 * Gives up on the ring after a fatal error: every outstanding read fails, blocked
+                 * submitters are released, and later reads go to the pool. Called on the reaper thread
+                 * with the lock held; returns with it released.
+                 */
+                void breakRing(std::unique_lock<std::mutex> &lock, int error)
+                {
+                    _broken = true;
+                    std::unordered_set<ReadRequest *> pending;
+                    pending.swap(_pending);
+                    _inFlight = 0;
+                    lock.unlock();
+                    _slots.notify_all();
+
+                    for (ReadRequest *request : pending)
+                    {
+                        fail(request, error);
+                    }
+                }
+
+                void reap()
+                {
+                    bool stopping = false;
+                    while (!stopping)
+                    {
+                        // Also submits entries left queued by a busy ring (see pushSqe()).
+                        const unsigned queued = __atomic_load_n(_sqTail, __ATOMIC_ACQUIRE) -
+                                                __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+                        long ret = syscall(__NR_io_uring_enter, _ringFd, queued, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        if (ret < 0 && queued != 0 && (errno == EAGAIN || errno == EBUSY))
+                        {
+                            // Still busy: just collect completions, which is what frees the ring.
+                            ret = syscall(__NR_io_uring_enter, _ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                        }
+                        if (ret < 0 && errno != EINTR)
+                        {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            breakRing(lock, errno);
+                            break;
+                        }
+
+                        std::vector<std::pair<ReadRequest *, int>> completed;
+                        unsigned head = *_cqHead;
+                        const unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+                        for (; head != tail; ++head)
+                        {
+                            const struct io_uring_cqe &cqe = _cqes[head & _cqMask];
+                            if (cqe.user_data == 0)
+                            {
+                                stopping = true;
+                                continue;
+                            }
+                            completed.emplace_back(reinterpret_cast<ReadRequest *>(cqe.user_data), cqe.res);
+                        }
+                        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+
+                        for (const auto &[request, res] : completed)
+                        {
+                            if (res < 0)
+                            {
+                                release(request);
+                                fail(request, -res);
+                                continue;
+                            }
+
+                            request->offset += static_cast<std::size_t>(res);
+                            if (res == 0 || request->offset >= request->buffer.size())
+                            {
+                                // Short file (EOF before the stat size) or fully read.
+                                request->buffer.resize(request->offset);
+                                release(request);
+                                finish(request);
+                                continue;
+                            }
+
+                            // Short read: queue the remainder, keeping the request's slot.
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            if (!pushRead(lock, request))
+                            {
+                                const int error = errno;
+                                _pending.erase(request);
+                                --_inFlight;
+                                lock.unlock();
+                                _slots.notify_one();
+                                fail(request, error);
+                            }
+                        }
+                    }
+                }
+
+                void release(ReadRequest *request)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _pending.erase(request);
+                        --_inFlight;
+                    }
+                    _slots.notify_one();
+                }
+
+                int _ringFd{-1};
+                void *_sqRing{nullptr};
+                void *_cqRing{nullptr};
+                std::size_t _sqRingSize{0};
+                std::size_t _cqRingSize{0};
+                std::size_t _sqesSize{0};
+                struct io_uring_sqe *_sqes{nullptr};
+                unsigned *_sqHead{nullptr};
+                unsigned *_sqTail{nullptr};
+                unsigned *_sqArray{nullptr};
+                unsigned _sqMask{0};
+                unsigned *_cqHead{nullptr};
+                unsigned *_cqTail{nullptr};
+                unsigned _cqMask{0};
+                struct io_uring_cqe *_cqes{nullptr};
+
+                unsigned _entries{0};
+                unsigned _inFlight{0};
+                // Requests submitted and not yet finished or failed; guarded by _mutex.
+                std::unordered_set<ReadRequest *> _pending;
+                std::atomic<bool> _broken{false};
+                std::mutex _mutex;
+                std::condition_variable _slots;
+                std::thread _reaper;
+            };
+#endif // EASYJSON_HAVE_IO_URING
+        } // ! anonymous namespace
+
+        ThreadPool &ThreadPool::instance()
+        {
+            static ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()));
+            return pool;
+        }
+
+        ThreadPool::ThreadPool(std::size_t workers)
+        {
+            _workers.reserve(workers);
+            for (std::size_t i = 0; i < workers; ++i)
+            {
+                _workers.emplace_back(&ThreadPool::run, this);
+            }
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _condition.notify_all();
+            for (auto &worker : _workers)
+            {
+                worker.join();
+            }
+        }
+
+        void ThreadPool::post(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _tasks.push_back(std::move(task));
+            }
+            _condition.notify_one();
+        }
+
+        void ThreadPool::run()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _condition.wait(lock, [this]
+                                    { return _stopping || !_tasks.empty(); });
+                    // Drain the queue before exiting so no pending load is dropped.
+                    if (_tasks.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(_tasks.front());
+                    _tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        bool ioUringAvailable()
+        {
+#ifdef EASYJSON_HAVE_IO_URING
+            if (!uringEnabled.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+            const UringReader *reader = UringReader::instance();
+            return reader != nullptr && !reader->broken();
+#else
+            return false;
+#endif
+        }
+
+        void readFileAsync(const std::string &path, ReadCallback callback)
+        {
+#ifdef EASYJSON_HAVE_IO_URING
+            UringReader *reader = uringEnabled.load(std::memory_order_relaxed) ? UringReader::instance() : nullptr;
+            if (reader && !reader->broken())
+            {
+                const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd < 0)
+                {
+                    callback({}, std::make_exception_ptr(std::runtime_error("Could not open config file: " + path)));
+                    return;
+                }
+
+                struct stat info;
+                if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+                {
+                    // Pipes, procfs entries and the like have no usable size: read them the slow way.
+                    close(fd);
+                    readFileOnPool(path, std::move(callback));
+                    return;
+                }
+
+                auto request = std::make_unique<ReadRequest>();
+                request->fd = fd;
+                request->path = path;
+                request->buffer.resize(static_cast<std::size_t>(info.st_size));
+                request->callback = std::move(callback);
+                request = reader->submit(std::move(request));
+                if (!request)
+                {
+                    return;
+                }
+
+                // The ring failed in the meantime.
+                close(request->fd);
+                callback = std::move(request->callback);
+            }
+#endif
+            readFileOnPool(path, std::move(callback));
+        }
+
+        void setIoUringEnabled(bool enabled)
+        {
+            uringEnabled.store(enabled, std::memory_order_relaxed);
+        }
+
+    } // ! detail namespace
+} // ! EasyJson namespace
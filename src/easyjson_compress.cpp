@@ -0,0 +1,325 @@
+#include "easyjson_compress.h"
+
+#include <climits>
+#include <cstring>
+#include <zlib.h>
+
+#ifdef EASYJSON_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace easyjson
+{
+    namespace detail
+    {
+        namespace
+        {
+            // Compressed input is read through a window of this size.
+            constexpr std::size_t kWindowSize = 64 * 1024;
+
+            // Upper bound for sizing the output from an untrusted header; beyond it the buffer grows as needed.
+            constexpr std::uint64_t kMaxPresize = std::uint64_t(64) << 20;
+
+            // Deflate cannot expand data by more than about 1032:1, so a size claimed beyond that is forged.
+            constexpr std::uint64_t kMaxRatio = 1032;
+
+            // Returns the next chunk of compressed input; an empty view marks the end of the input.
+            using Fill = std::function<std::string_view()>;
+
+            // The size hint comes from the (untrusted) input: it is bounded by what the compressed size can expand to.
+            std::string presized(std::uint64_t sizeHint, std::uint64_t compressedSize)
+            {
+                const std::uint64_t bound = std::min(compressedSize * kMaxRatio, kMaxPresize);
+                std::string text;
+                text.resize(static_cast<std::size_t>(std::max<std::uint64_t>(std::min(sizeHint, bound), kWindowSize)));
+                return text;
+            }
+
+            /** @brief
+             * Inflates gzip or zlib data straight into the output buffer.
+             * Concatenated gzip members (pigz, cat a.gz b.gz) are decoded one after the other.
+             */
+            std::string inflateAll(const Fill &fill, std::uint64_t sizeHint, std::uint64_t compressedSize,
+                                   const std::string &name)
+            {
+                z_stream stream{};
+                // 15 + 32: largest window, detect the gzip or zlib header automatically.
+                if (inflateInit2(&stream, 15 + 32) != Z_OK)
+                {
+                    throw std::runtime_error("Could not initialize zlib for " + name);
+                }
+                const std::unique_ptr<z_stream, int (*)(z_stream *)> guard(&stream, inflateEnd);
+
+                std::string text = presized(sizeHint, compressedSize);
+                std::size_t produced = 0;
+                bool finished = false;
+                bool outputFull = false;
+                while (!finished)
+                {
+                    // A full output buffer may hide more decoded data inside the decoder.
+                    if (stream.avail_in == 0 && !outputFull)
+                    {
+                        const std::string_view chunk = fill();
+                        if (chunk.empty())
+                        {
+                            break;
+                        }
+                        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(chunk.data()));
+                        stream.avail_in = static_cast<uInt>(chunk.size());
+                    }
+
+                    if (produced == text.size())
+                    {
+                        text.resize(text.size() * 2);
+                    }
+                    const std::size_t room = std::min<std::size_t>(text.size() - produced, UINT_MAX);
+                    stream.next_out = reinterpret_cast<Bytef *>(&text[produced]);
+                    stream.avail_out = static_cast<uInt>(room);
+                    const int status = inflate(&stream, Z_NO_FLUSH);
+                    produced += room - stream.avail_out;
+                    outputFull = stream.avail_out == 0;
+
+                    if (status == Z_STREAM_END)
+                    {
+                        outputFull = false;
+                        if (stream.avail_in == 0)
+                        {
+                            const std::string_view chunk = fill();
+                            if (chunk.empty())
+                            {
+                                finished = true;
+                                continue;
+                            }
+                            stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(chunk.data()));
+                            stream.avail_in = static_cast<uInt>(chunk.size());
+                        }
+                        inflateReset(&stream);
+                    }
+                    else if (status != Z_OK && status != Z_BUF_ERROR)
+                    {
+                        throw std::runtime_error("Corrupt compressed data in " + name + ": " +
+                                                 (stream.msg ? stream.msg : "inflate error"));
+                    }
+                }
+
+                if (!finished)
+                {
+                    throw std::runtime_error("Truncated compressed data in " + name);
+                }
+                text.resize(produced);
+                return text;
+            }
+
+#ifdef EASYJSON_WITH_ZSTD
+            /** @brief
+             * Decompresses zstd data (one or more frames) straight into the output buffer.
+             */
+            std::string decompressZstd(const Fill &fill, std::string_view first, std::uint64_t compressedSize,
+                                       const std::string &name)
+            {
+                const std::unique_ptr<ZSTD_DStream, std::size_t (*)(ZSTD_DStream *)> stream(ZSTD_createDStream(),
+                                                                                         ZSTD_freeDStream);
+                if (!stream)
+                {
+                    throw std::runtime_error("Could not initialize zstd for " + name);
+                }
+
+                // zstd allows higher ratios than deflate, but a claimed size is still not trusted beyond the same bound.
+                const unsigned long long contentSize = ZSTD_getFrameContentSize(first.data(), first.size());
+                std::string text = presized(contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize == ZSTD_CONTENTSIZE_ERROR
+                                                ? compressedSize * 4
+                                                : contentSize,
+                                            compressedSize);
+
+                std::size_t produced = 0;
+                std::size_t pending = 1; // Non-zero until the last frame is complete and flushed.
+                for (std::string_view chunk = first; !chunk.empty(); chunk = fill())
+                {
+                    ZSTD_inBuffer input{chunk.data(), chunk.size(), 0};
+                    bool outputFull = false;
+                    while (input.pos < input.size || outputFull)
+                    {
+                        if (produced == text.size())
+                        {
+                            text.resize(text.size() * 2);
+                        }
+                        ZSTD_outBuffer output{&text[produced], text.size() - produced, 0};
+                        pending = ZSTD_decompressStream(stream.get(), &output, &input);
+                        if (ZSTD_isError(pending))
+                        {
+                            throw std::runtime_error("Corrupt compressed data in " + name + ": " +
+                                                     ZSTD_getErrorName(pending));
+                        }
+                        produced += output.pos;
+                        // A full output buffer may hide more decoded data inside the decoder.
+                        outputFull = output.pos == output.size;
+                    }
+                }
+
+                if (pending != 0)
+                {
+                    throw std::runtime_error("Truncated compressed data in " + name);
+                }
+                text.resize(produced);
+                return text;
+            }
+#endif
+
+            std::string decompressWith(Compression compression, const Fill &fill, std::string_view first,
+                                       std::uint64_t sizeHint, std::uint64_t compressedSize, const std::string &name)
+            {
+                if (compression == Compression::Gzip)
+                {
+                    bool consumedFirst = false;
+                    return inflateAll([&]() -> std::string_view
+                                      {
+                        if (!consumedFirst)
+                        {
+                            consumedFirst = true;
+                            return first;
+                        }
+                        return fill(); },
+                                      sizeHint, compressedSize, name);
+                }
+
+#ifdef EASYJSON_WITH_ZSTD
+                (void)sizeHint;
+                return decompressZstd(fill, first, compressedSize, name);
+#else
+                (void)fill;
+                (void)first;
+                (void)sizeHint;
+                (void)compressedSize;
+                throw std::runtime_error(name + " is zstd-compressed, but zstd support is not built in "
+                                                "(configure with -DEASYJSON_WITH_ZSTD=ON)");
+#endif
+            }
+        } // ! anonymous namespace
+
+        Compression detectCompression(std::string_view head)
+        {
+            const auto byte = [&](std::size_t i)
+            { return static_cast<unsigned char>(head[i]); };
+
+            if (head.size() >= 2 && byte(0) == 0x1f && byte(1) == 0x8b)
+            {
+                return Compression::Gzip;
+            }
+            // A zlib stream starts with CMF 0x78 and a header checksum; no JSON text starts with 'x'.
+            if (head.size() >= 2 && byte(0) == 0x78 && ((byte(0) << 8) | byte(1)) % 31 == 0)
+            {
+                return Compression::Gzip;
+            }
+            if (head.size() >= 4 && byte(0) == 0x28 && byte(1) == 0xb5 && byte(2) == 0x2f && byte(3) == 0xfd)
+            {
+                return Compression::Zstd;
+            }
+            return Compression::None;
+        }
+
+        /** @brief
+         * Reads a configuration file, decompressing gzip/zlib (and zstd if enabled) on the fly.
+         * Compressed input goes through a fixed 64 KB window; the output buffer is sized from the
+         * gzip ISIZE trailer so the text is usually written once, without intermediate copies.
+         * The trailer is not trusted beyond what the file size can expand to: past that bound the
+         * buffer grows as the data is decoded.
+         *
+         * @param path The configuration file.
+         * @return The (decompressed) JSON text.
+         * @throw std::runtime_error If the file cannot be opened or the compressed data is corrupt.
+         */
+        std::string readConfigFile(const std::string &path)
+        {
+            std::ifstream file(path, std::ios::in | std::ios::binary);
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Could not open config file: " + path);
+            }
+            std::streambuf &input = *file.rdbuf();
+
+            std::vector<char> window(kWindowSize);
+            const std::size_t headSize = static_cast<std::size_t>(input.sgetn(window.data(), 4));
+            const Compression compression = detectCompression(std::string_view(window.data(), headSize));
+
+            std::error_code error;
+            const std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+
+            if (compression == Compression::None)
+            {
+                // One extra byte so that reaching the end does not trigger a resize.
+                std::string text(error ? kWindowSize : static_cast<std::size_t>(fileSize) + 1, '\0');
+                std::memcpy(&text[0], window.data(), headSize);
+                std::size_t used = headSize;
+                for (;;)
+                {
+                    if (used == text.size())
+                    {
+                        text.resize(text.size() * 2);
+                    }
+                    const std::streamsize count = input.sgetn(&text[used], static_cast<std::streamsize>(text.size() - used));
+                    if (count <= 0)
+                    {
+                        break;
+                    }
+                    used += static_cast<std::size_t>(count);
+                }
+                text.resize(used);
+                return text;
+            }
+
+            // The gzip trailer (not the zlib one) holds the uncompressed size modulo 2^32 (exact for a single member under 4 GB).
+            std::uint64_t sizeHint = error ? 0 : fileSize * 4;
+            if (static_cast<unsigned char>(window[0]) == 0x1f && !error && fileSize >= 18 &&
+                input.pubseekoff(-4, std::ios::end, std::ios::in) != std::streampos(-1))
+            {
+                unsigned char trailer[4];
+                if (input.sgetn(reinterpret_cast<char *>(trailer), 4) == 4)
+                {
+                    sizeHint = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (std::uint64_t(trailer[3]) << 24);
+                }
+                input.pubseekpos(static_cast<std::streamoff>(headSize), std::ios::in);
+            }
+
+            // The first chunk is the window including the magic bytes already read.
+            const std::size_t firstSize = headSize + static_cast<std::size_t>(
+                                                         std::max<std::streamsize>(0, input.sgetn(window.data() + headSize,
+                                                                                                  kWindowSize - headSize)));
+            const Fill fill = [&]() -> std::string_view
+            {
+                const std::streamsize count = input.sgetn(window.data(), kWindowSize);
+                return count > 0 ? std::string_view(window.data(), static_cast<std::size_t>(count)) : std::string_view();
+            };
+            return decompressWith(compression, fill, std::string_view(window.data(), firstSize), sizeHint,
+                                  error ? firstSize : fileSize, path);
+        }
+
+        /** @brief
+         * Decompresses a configuration already read into memory (e.g. by readFileAsync()).
+         *
+         * @param content The file content.
+         * @param name Used in error messages.
+         * @return The (decompressed) JSON text; uncompressed content is returned as is.
+         * @throw std::runtime_error If the compressed data is corrupt.
+         */
+        std::string decompress(std::string content, const std::string &name)
+        {
+            const Compression compression = detectCompression(content);
+            if (compression == Compression::None)
+            {
+                return content;
+            }
+
+            std::uint64_t sizeHint = content.size() * 4;
+            if (static_cast<unsigned char>(content[0]) == 0x1f && content.size() >= 18)
+            {
+                const auto *trailer = reinterpret_cast<const unsigned char *>(content.data() + content.size() - 4);
+                sizeHint = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (std::uint64_t(trailer[3]) << 24);
+            }
+
+            const Fill end = []
+            { return std::string_view(); };
+            return decompressWith(compression, end, content, sizeHint, content.size(), name);
+        }
+
+    } // ! detail namespace
+} // ! EasyJson namespace
@@ -0,0 +1,134 @@
+#include "easyjson_intern.h"
+
+namespace easyjson
+{
+    // Copies re-intern every string in ID order, so IDs stay valid across the copy.
+    StringPool::StringPool(const StringPool &other)
+    {
+        for (const auto &value : other._views)
+        {
+            intern(value);
+        }
+    }
+
+    StringPool &StringPool::operator=(const StringPool &other)
+    {
+        if (this != &other)
+        {
+            clear();
+            for (const auto &value : other._views)
+            {
+                intern(value);
+            }
+        }
+        return *this;
+    }
+
+    StringPool::StringPool(StringPool &&other)
+        : _blocks(std::move(other._blocks)),
+          _current(std::exchange(other._current, nullptr)),
+          _blockUsed(std::exchange(other._blockUsed, 0)),
+          _arenaBytes(std::exchange(other._arenaBytes, 0)),
+          _views(std::move(other._views)),
+          _index(std::move(other._index))
+    {
+        // The moved containers are left unspecified; the arena cursor must not point into our blocks.
+        other.clear();
+    }
+
+    StringPool &StringPool::operator=(StringPool &&other)
+    {
+        if (this != &other)
+        {
+            _blocks = std::move(other._blocks);
+            _current = std::exchange(other._current, nullptr);
+            _blockUsed = std::exchange(other._blockUsed, 0);
+            _arenaBytes = std::exchange(other._arenaBytes, 0);
+            _views = std::move(other._views);
+            _index = std::move(other._index);
+            other.clear();
+        }
+        return *this;
+    }
+
+    /** @brief
+     * Interns a string. Strings are packed back to back into fixed-size arena blocks;
+     * strings larger than a quarter of a block get a dedicated block of their own.
+     *
+     * @param value The string to intern.
+     * @return The ID of the interned string.
+     */
+    StringPool::Id StringPool::intern(std::string_view value)
+    {
+        const auto found = _index.find(value);
+        if (found != _index.end())
+        {
+            return found->second;
+        }
+
+        if (_views.size() >= npos)
+        {
+            throw std::runtime_error("String pool is full.");
+        }
+
+        char *storage = nullptr;
+        if (value.size() > kBlockSize / 4)
+        {
+            // Large strings get a block of their own so they do not waste the current one.
+            _blocks.emplace_back(new char[value.size()]);
+            _arenaBytes += value.size();
+            storage = _blocks.back().get();
+        }
+        else
+        {
+            if (!_current || value.size() > kBlockSize - _blockUsed)
+            {
+                _blocks.emplace_back(new char[kBlockSize]);
+                _arenaBytes += kBlockSize;
+                _current = _blocks.back().get();
+                _blockUsed = 0;
+            }
+            storage = _current + _blockUsed;
+            _blockUsed += value.size();
+        }
+
+        std::memcpy(storage, value.data(), value.size());
+
+        const std::string_view stored(storage, value.size());
+        const Id id = static_cast<Id>(_views.size());
+        _views.push_back(stored);
+        _index.emplace(stored, id);
+        return id;
+    }
+
+    StringPool::Id StringPool::find(std::string_view value) const
+    {
+        const auto found = _index.find(value);
+        return found == _index.end() ? npos : found->second;
+    }
+
+    /** @brief
+     * Approximate heap footprint of the pool: arena blocks, the ID table and the hash index.
+     */
+    std::size_t StringPool::memoryUsage() const
+    {
+        // Each unordered_map node holds the pair plus a next pointer (and the cached hash).
+        const std::size_t nodeBytes = sizeof(std::pair<const std::string_view, Id>) + 2 * sizeof(void *);
+
+        return _arenaBytes +
+               _blocks.capacity() * sizeof(std::unique_ptr<char[]>) +
+               _views.capacity() * sizeof(std::string_view) +
+               _index.size() * nodeBytes +
+               _index.bucket_count() * sizeof(void *);
+    }
+
+    void StringPool::clear()
+    {
+        _index.clear();
+        _views.clear();
+        _blocks.clear();
+        _current = nullptr;
+        _blockUsed = 0;
+        _arenaBytes = 0;
+    }
+} // ! EasyJson namespace
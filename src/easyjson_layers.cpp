@@ -0,0 +1,144 @@
+#include "easyjson_layers.h"
+
+namespace easyjson
+{
+    LayeredConfig::LayeredConfig()
+        : _index(std::make_shared<const Index>())
+    {
+    }
+
+    /** @brief
+     * Builds a base layer holding one immutable section per member of the configuration map.
+     *
+     * @param configMap The parsed configuration data.
+     * @return The base layer.
+     */
+    LayeredConfig LayeredConfig::fromMap(const std::unordered_map<std::string,
+                                                                  std::unordered_map<std::string, std::string>> &configMap)
+    {
+        auto index = std::make_shared<Index>();
+        index->reserve(configMap.size());
+
+        for (const auto &member : configMap)
+        {
+            auto section = std::make_shared<const ConfigSection>(ConfigSection{member.first, member.second});
+            index->emplace(section->name, std::move(section));
+        }
+
+        LayeredConfig base;
+        base._index = std::move(index);
+        base._layers = 1;
+        return base;
+    }
+
+    /** @brief
+     * Creates an override layer. The merged index of this layer is copied (pointers only);
+     * each overridden section is copied once, patched, and replaces the shared one.
+     * Sections that do not exist yet are added.
+     *
+     * @param overrides Section name to key/value pairs that replace or extend this layer.
+     * @return The new layer; this layer is left untouched.
+     */
+    LayeredConfig LayeredConfig::withOverrides(const std::unordered_map<std::string,
+                                                                        std::unordered_map<std::string, std::string>> &overrides) const
+    {
+        LayeredConfig layer;
+        layer._layers = _layers + 1;
+
+        if (overrides.empty())
+        {
+            // Nothing to patch: share the whole index.
+            layer._index = _index;
+            return layer;
+        }
+
+        auto index = std::make_shared<Index>(*_index);
+        for (const auto &member : overrides)
+        {
+            auto patched = std::make_shared<ConfigSection>();
+            const auto existing = index->find(member.first);
+            if (existing != index->end())
+            {
+                *patched = *existing->second;
+                // The key views the old section's name: drop it before the section can go away.
+                index->erase(existing);
+            }
+            else
+            {
+                patched->name = member.first;
+            }
+
+            for (const auto &value : member.second)
+            {
+                patched->values[value.first] = value.second;
+            }
+
+            const std::string_view name = patched->name;
+            index->emplace(name, std::move(patched));
+        }
+
+        layer._index = std::move(index);
+        return layer;
+    }
+
+    const std::string *LayeredConfig::find(std::string_view section, const std::string &key) const
+    {
+        const auto sectionIt = _index->find(section);
+        if (sectionIt == _index->end())
+        {
+            return nullptr;
+        }
+
+        const auto &values = sectionIt->second->values;
+        const auto valueIt = values.find(key);
+        return valueIt == values.end() ? nullptr : &valueIt->second;
+    }
+
+    const std::string *LayeredConfig::find(std::string_view section, std::string_view key) const
+    {
+        return find(section, std::string(key));
+    }
+
+    /** @brief
+     * Retrieves the value of a key in the merged view.
+     *
+     * @throw std::runtime_error If the section or key does not exist.
+     */
+    const std::string &LayeredConfig::get(std::string_view section, const std::string &key) const
+    {
+        const std::string *value = find(section, key);
+        if (!value)
+        {
+            throw std::runtime_error("Error retrieving " + std::string(section) + "." + key + " from layered config");
+        }
+        return *value;
+    }
+
+    const std::string &LayeredConfig::get(std::string_view section, std::string_view key) const
+    {
+        return get(section, std::string(key));
+    }
+
+    LayeredConfig::SectionPtr LayeredConfig::section(std::string_view name) const
+    {
+        const auto found = _index->find(name);
+        return found == _index->end() ? nullptr : found->second;
+    }
+
+    bool LayeredConfig::sharesSection(const LayeredConfig &other, std::string_view name) const
+    {
+        const SectionPtr mine = section(name);
+        return mine && mine == other.section(name);
+    }
+
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>> LayeredConfig::toMap() const
+    {
+        std::unordered_map<std::string, std::unordered_map<std::string, std::string>> configMap;
+        configMap.reserve(_index->size());
+        for (const auto &entry : *_index)
+        {
+            configMap.emplace(entry.second->name, entry.second->values);
+        }
+        return configMap;
+    }
+} // ! EasyJson namespace
@@ -0,0 +1,371 @@
+#include "easyjson_profile.h"
+
+namespace easyjson
+{
+    // Per-thread sample counts. The owning thread is the only writer, so its lock is uncontended
+    // except while a report is being merged. It registers itself with the profiler and, when its
+    // thread exits, folds its counts into the retired total and unregisters.
+    struct KeyProfiler::ThreadTable
+    {
+        explicit ThreadTable(KeyProfiler &profiler) : owner(profiler)
+        {
+            std::lock_guard<std::mutex> lock(owner._mutex);
+            owner._tables.push_back(this);
+        }
+
+        ~ThreadTable()
+        {
+            std::lock_guard<std::mutex> lock(owner._mutex);
+            for (const auto &entry : counts)
+            {
+                owner._retired[entry.first] += entry.second;
+            }
+            owner._tables.erase(std::find(owner._tables.begin(), owner._tables.end(), this));
+        }
+
+        KeyProfiler &owner;
+        std::mutex mutex;
+        std::unordered_map<std::string, std::uint64_t> counts;
+    };
+
+    namespace
+    {
+        // Section and key are joined with a separator that cannot appear in a JSON key unescaped.
+        constexpr char kSeparator = '\x1f';
+
+        std::string profileKey(std::string_view section, std::string_view key)
+        {
+            std::string joined;
+            joined.reserve(section.size() + key.size() + 1);
+            joined.append(section).push_back(kSeparator);
+            joined.append(key);
+            return joined;
+        }
+    } // ! anonymous namespace
+
+    KeyProfiler &KeyProfiler::instance()
+    {
+        static KeyProfiler profiler;
+        return profiler;
+    }
+
+    void KeyProfiler::enable(std::uint32_t sampleEvery)
+    {
+        _sampleEvery.store(std::max<std::uint32_t>(1, sampleEvery), std::memory_order_relaxed);
+        _enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /** @brief
+     * Records one sampled lookup and returns how many lookups to skip before the next sample.
+     * The interval is jittered around the sampling rate so that request paths reading keys in a
+     * fixed cycle do not always land on the same key.
+     */
+    std::uint32_t KeyProfiler::sample(std::string_view section, std::string_view key)
+    {
+        thread_local ThreadTable table(*this);
+
+        {
+            std::lock_guard<std::mutex> lock(table.mutex);
+            ++table.counts[profileKey(section, key)];
+        }
+
+        // xorshift32: uniform skip in [0, 2 * rate - 2], so one lookup in rate is sampled on average.
+        thread_local std::uint32_t state = 0x9e3779b9u ^ static_cast<std::uint32_t>(
+                                                             std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        const std::uint32_t rate = _sampleEvery.load(std::memory_order_relaxed);
+        return rate <= 1 ? 0 : state % (2 * rate - 1);
+    }
+
+    /** @brief
+     * Merges the per-thread tables, and the counts of threads that have exited, into one report.
+     *
+     * @param top Maximum number of keys to return; 0 for all of them.
+     * @return Keys sorted by estimated access count, hottest first.
+     */
+    std::vector<HotKey> KeyProfiler::report(std::size_t top) const
+    {
+        std::unordered_map<std::string, std::uint64_t> merged;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            merged = _retired;
+            for (ThreadTable *table : _tables)
+            {
+                std::lock_guard<std::mutex> tableLock(table->mutex);
+                for (const auto &entry : table->counts)
+                {
+                    merged[entry.first] += entry.second;
+                }
+            }
+        }
+
+        const std::uint64_t rate = _sampleEvery.load(std::memory_order_relaxed);
+        std::vector<HotKey> hotKeys;
+        hotKeys.reserve(merged.size());
+        for (const auto &entry : merged)
+        {
+            const auto separator = entry.first.find(kSeparator);
+            hotKeys.push_back({entry.first.substr(0, separator), entry.first.substr(separator + 1), entry.second * rate});
+        }
+
+        std::sort(hotKeys.begin(), hotKeys.end(), [](const HotKey &a, const HotKey &b)
+                  { return a.count != b.count ? a.count > b.count
+                                              : std::tie(a.section, a.key) < std::tie(b.section, b.key); });
+        if (top && hotKeys.size() > top)
+        {
+            hotKeys.resize(top);
+        }
+        return hotKeys;
+    }
+
+    std::string KeyProfiler::dump(std::size_t top) const
+    {
+        std::ostringstream out;
+        out << "Hot keys (1 in " << _sampleEvery.load(std::memory_order_relaxed) << " lookups sampled):\n";
+        for (const auto &hotKey : report(top))
+        {
+            out << "  " << std::setw(12) << hotKey.count << "  "
+                << (hotKey.section.empty() ? "" : hotKey.section + ".") << hotKey.key << "\n";
+        }
+        return out.str();
+    }
+
+    void KeyProfiler::reset()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _retired.clear();
+        for (ThreadTable *table : _tables)
+        {
+            std::lock_guard<std::mutex> tableLock(table->mutex);
+            table->counts.clear();
+        }
+    }
+
+    /** @brief
+     * Saves a hot-key report as JSON so the next run can lay its store out before any lookup.
+     *
+     * @throw std::runtime_error If the file cannot be written.
+     */
+    void KeyProfiler::save(const std::string &path, const std::vector<HotKey> &hotKeys)
+    {
+        Json::Value root;
+        Json::Value &keys = root["hotKeys"] = Json::Value(Json::arrayValue);
+        for (const auto &hotKey : hotKeys)
+        {
+            Json::Value entry;
+            entry["section"] = hotKey.section;
+            entry["key"] = hotKey.key;
+            entry["count"] = Json::UInt64(hotKey.count);
+            keys.append(entry);
+        }
+
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not write profile file: " + path);
+        }
+        file << root;
+    }
+
+    /** @brief
+     * Loads a hot-key report written by save().
+     *
+     * @throw std::runtime_error If the file cannot be read or is not a profile.
+     */
+    std::vector<HotKey> KeyProfiler::load(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open profile file: " + path);
+        }
+
+        Json::Value root;
+        file >> root;
+        if (!root.isObject() || !root["hotKeys"].isArray())
+        {
+            throw std::runtime_error("Invalid profile file: " + path);
+        }
+
+        std::vector<HotKey> hotKeys;
+        for (const auto &entry : root["hotKeys"])
+        {
+            hotKeys.push_back({entry["section"].asString(), entry["key"].asString(), entry["count"].asUInt64()});
+        }
+        return hotKeys;
+    }
+
+    std::uint32_t HotKeyCache::hash(std::string_view section, std::string_view key)
+    {
+        // The cache never leaves the process, so the library hash is fine here.
+        const std::size_t combined = std::hash<std::string_view>{}(section) * 31 + std::hash<std::string_view>{}(key);
+        return static_cast<std::uint32_t>(combined ^ (combined >> 32));
+    }
+
+    // Copies duplicate the slot table and the arena; offsets are relative, so nothing is rebased.
+    HotKeyCache::HotKeyCache(const HotKeyCache &other)
+    {
+        *this = other;
+    }
+
+    HotKeyCache &HotKeyCache::operator=(const HotKeyCache &other)
+    {
+        if (this != &other)
+        {
+            clear();
+            if (other._mask)
+            {
+                allocate(other._mask + 1, other._arenaSize);
+                std::memcpy(_slots.get(), other._slots.get(), (other._mask + 1) * sizeof(Slot));
+                std::memcpy(_arena.get(), other._arena.get(), other._arenaSize);
+                _arenaSize = other._arenaSize;
+                _size = other._size;
+            }
+        }
+        return *this;
+    }
+
+    HotKeyCache::HotKeyCache(HotKeyCache &&other) noexcept
+        : _slots(std::move(other._slots)),
+          _arena(std::move(other._arena)),
+          _arenaSize(std::exchange(other._arenaSize, 0)),
+          _mask(std::exchange(other._mask, 0)),
+          _size(std::exchange(other._size, 0))
+    {
+    }
+
+    HotKeyCache &HotKeyCache::operator=(HotKeyCache &&other) noexcept
+    {
+        if (this != &other)
+        {
+            _slots = std::move(other._slots);
+            _arena = std::move(other._arena);
+            _arenaSize = std::exchange(other._arenaSize, 0);
+            _mask = std::exchange(other._mask, 0);
+            _size = std::exchange(other._size, 0);
+        }
+        return *this;
+    }
+
+    // Allocates a cache-line aligned slot table and arena; slotCount is a power of two.
+    void HotKeyCache::allocate(std::size_t slotCount, std::size_t arenaSize)
+    {
+        constexpr std::size_t kCacheLine = 64;
+        const auto roundUp = [](std::size_t bytes)
+        { return (bytes + kCacheLine - 1) / kCacheLine * kCacheLine; };
+
+        _slots.reset(static_cast<Slot *>(std::aligned_alloc(kCacheLine, roundUp(slotCount * sizeof(Slot)))));
+        _arena.reset(static_cast<char *>(std::aligned_alloc(kCacheLine, roundUp(std::max<std::size_t>(arenaSize, 1)))));
+        if (!_slots || !_arena)
+        {
+            clear();
+            throw std::bad_alloc();
+        }
+        _mask = slotCount - 1;
+    }
+
+    /** @brief
+     * Copies the hot entries into a cache-line aligned slot table and a single arena, in the
+     * order given (hottest first), so the hottest values sit next to each other in memory.
+     *
+     * @param hotKeys The entries to cache, hottest first.
+     * @param value Returns the current value of an entry, or null if it does not exist.
+     */
+    void HotKeyCache::build(const std::vector<HotKey> &hotKeys,
+                            const std::function<const std::string *(const std::string &, const std::string &)> &value)
+    {
+        clear();
+
+        std::vector<std::pair<const HotKey *, const std::string *>> entries;
+        std::size_t arenaSize = 0;
+        for (const auto &hotKey : hotKeys)
+        {
+            const std::string *current = value(hotKey.section, hotKey.key);
+            if (current && !(hotKey.section.empty() && hotKey.key.empty()) &&
+                hotKey.section.size() <= UINT16_MAX && hotKey.key.size() <= UINT16_MAX)
+            {
+                entries.emplace_back(&hotKey, current);
+                arenaSize += hotKey.section.size() + hotKey.key.size() + current->size();
+            }
+        }
+        if (entries.empty())
+        {
+            return;
+        }
+
+        // Keep the table at most half full so probes stay short.
+        std::size_t slotCount = 4;
+        while (slotCount < entries.size() * 2)
+        {
+            slotCount *= 2;
+        }
+
+        allocate(slotCount, arenaSize);
+        std::memset(_slots.get(), 0, slotCount * sizeof(Slot));
+
+        std::size_t offset = 0;
+        for (const auto &entry : entries)
+        {
+            const HotKey &hotKey = *entry.first;
+            const std::string &current = *entry.second;
+
+            Slot slot{hash(hotKey.section, hotKey.key), static_cast<std::uint32_t>(offset),
+                      static_cast<std::uint16_t>(hotKey.section.size()), static_cast<std::uint16_t>(hotKey.key.size()),
+                      static_cast<std::uint32_t>(current.size())};
+            std::memcpy(_arena.get() + offset, hotKey.section.data(), hotKey.section.size());
+            offset += hotKey.section.size();
+            std::memcpy(_arena.get() + offset, hotKey.key.data(), hotKey.key.size());
+            offset += hotKey.key.size();
+            std::memcpy(_arena.get() + offset, current.data(), current.size());
+            offset += current.size();
+
+            // An occupied slot has a non-zero total length; sections and keys are never both empty.
+            std::size_t index = slot.hash & _mask;
+            while (_slots.get()[index].sectionLength + _slots.get()[index].keyLength != 0)
+            {
+                index = (index + 1) & _mask;
+            }
+            _slots.get()[index] = slot;
+            ++_size;
+        }
+        _arenaSize = arenaSize;
+    }
+
+    void HotKeyCache::clear()
+    {
+        _slots.reset();
+        _arena.reset();
+        _arenaSize = 0;
+        _mask = 0;
+        _size = 0;
+    }
+
+    bool HotKeyCache::find(std::string_view section, std::string_view key, std::string_view &value) const
+    {
+        if (_size == 0)
+        {
+            return false;
+        }
+
+        const std::uint32_t wanted = hash(section, key);
+        for (std::size_t index = wanted & _mask;; index = (index + 1) & _mask)
+        {
+            const Slot &slot = _slots.get()[index];
+            if (slot.sectionLength + slot.keyLength == 0)
+            {
+                return false;
+            }
+
+            const char *bytes = _arena.get() + slot.offset;
+            if (slot.hash == wanted && slot.sectionLength == section.size() && slot.keyLength == key.size() &&
+                std::memcmp(bytes, section.data(), section.size()) == 0 &&
+                std::memcmp(bytes + section.size(), key.data(), key.size()) == 0)
+            {
+                value = std::string_view(bytes + section.size() + key.size(), slot.valueLength);
+                return true;
+            }
+        }
+    }
+} // ! EasyJson namespace
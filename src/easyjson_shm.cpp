@@ -0,0 +1,428 @@
+#include "easyjson_shm.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace easyjson
+{
+    namespace
+    {
+        constexpr std::uint32_t kControlMagic = 0x454a4343; // "EJCC"
+        constexpr std::uint32_t kDataMagic = 0x454a4344;    // "EJCD"
+        constexpr std::uint32_t kFormatVersion = 1;
+
+        struct ControlBlock
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::atomic<std::uint64_t> generation;
+        };
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                      "The generation counter must be lock-free to live in shared memory.");
+
+        struct DataHeader
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t generation;
+            std::uint64_t size;
+            std::uint32_t entryCount;
+            std::uint32_t bucketCount;
+            std::uint64_t entriesOffset;
+            std::uint64_t bucketsOffset;
+            std::uint64_t stringsOffset;
+        };
+
+        // String offsets are relative to the string blob; buckets hold entry index + 1, 0 when empty.
+        struct Entry
+        {
+            std::uint64_t hash;
+            std::uint32_t sectionOffset;
+            std::uint32_t sectionLength;
+            std::uint32_t keyOffset;
+            std::uint32_t keyLength;
+            std::uint32_t valueOffset;
+            std::uint32_t valueLength;
+        };
+
+        std::string segmentName(const std::string &name)
+        {
+            return (!name.empty() && name[0] == '/') ? name : "/" + name;
+        }
+
+        std::string dataSegmentName(const std::string &name, std::uint64_t generation)
+        {
+            return name + "." + std::to_string(generation);
+        }
+
+        // FNV-1a: stable across processes and builds, unlike std::hash.
+        std::uint64_t entryHash(std::string_view section, std::string_view key)
+        {
+            std::uint64_t hash = 14695981039346656037ull;
+            const auto mix = [&hash](std::string_view text)
+            {
+                for (const unsigned char c : text)
+                {
+                    hash = (hash ^ c) * 1099511628211ull;
+                }
+            };
+            mix(section);
+            hash = (hash ^ 0xff) * 1099511628211ull;
+            mix(key);
+            return hash;
+        }
+
+        std::runtime_error shmError(const std::string &what, const std::string &name)
+        {
+            return std::runtime_error(what + ": " + name + ": " + std::strerror(errno));
+        }
+
+        const ControlBlock *control(const void *mapping)
+        {
+            return static_cast<const ControlBlock *>(mapping);
+        }
+    } // ! anonymous namespace
+
+    SharedConfigPublisher::SharedConfigPublisher(const std::string &name)
+        : _name(segmentName(name))
+    {
+        const int fd = shm_open(_name.c_str(), O_CREAT | O_RDWR, 0644);
+        if (fd < 0)
+        {
+            throw shmError("Could not create shared memory segment", _name);
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 ||
+            (static_cast<std::size_t>(info.st_size) < sizeof(ControlBlock) && ftruncate(fd, sizeof(ControlBlock)) != 0))
+        {
+            const auto error = shmError("Could not size shared memory segment", _name);
+            close(fd);
+            throw error;
+        }
+
+        _control = mmap(nullptr, sizeof(ControlBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (_control == MAP_FAILED)
+        {
+            _control = nullptr;
+            throw shmError("Could not map shared memory segment", _name);
+        }
+
+        // A fresh segment is zero-filled: stamp it. An existing one keeps its generation counter.
+        auto *block = static_cast<ControlBlock *>(_control);
+        if (block->magic != kControlMagic)
+        {
+            block->version = kFormatVersion;
+            block->magic = kControlMagic;
+        }
+    }
+
+    SharedConfigPublisher::~SharedConfigPublisher()
+    {
+        if (_control)
+        {
+            munmap(_control, sizeof(ControlBlock));
+        }
+    }
+
+    std::uint64_t SharedConfigPublisher::generation() const
+    {
+        return control(_control)->generation.load(std::memory_order_acquire);
+    }
+
+    /** @brief
+     * Lays the configuration out as header | entries | hash buckets | strings in a new data
+     * segment, then publishes it by bumping the generation in the control segment. Identical
+     * strings are stored once. The previous generation's name is unlinked; processes that have
+     * it mapped keep using it until they refresh.
+     *
+     * @param configMap The parsed configuration data, e.g. from EasyJsonCPP::loadConfiguration().
+     * @return The new generation number.
+     * @throw std::runtime_error If the segment cannot be created.
+     */
+    std::uint64_t SharedConfigPublisher::publish(const std::unordered_map<std::string,
+                                                                          std::unordered_map<std::string, std::string>> &configMap)
+    {
+        std::string strings;
+        std::unordered_map<std::string_view, std::uint32_t> stringOffsets;
+        const auto store = [&](const std::string &text)
+        {
+            const auto found = stringOffsets.find(text);
+            if (found != stringOffsets.end())
+            {
+                return found->second;
+            }
+            if (strings.size() + text.size() > UINT32_MAX)
+            {
+                throw std::runtime_error("Configuration too large for shared memory: " + _name);
+            }
+            const auto offset = static_cast<std::uint32_t>(strings.size());
+            strings += text;
+            // Views into the source map, which outlives this function.
+            stringOffsets.emplace(text, offset);
+            return offset;
+        };
+
+        std::vector<Entry> entries;
+        for (const auto &section : configMap)
+        {
+            for (const auto &value : section.second)
+            {
+                entries.push_back({entryHash(section.first, value.first),
+                                   store(section.first), static_cast<std::uint32_t>(section.first.size()),
+                                   store(value.first), static_cast<std::uint32_t>(value.first.size()),
+                                   store(value.second), static_cast<std::uint32_t>(value.second.size())});
+            }
+        }
+
+        // Open addressing with linear probing, kept at most half full.
+        std::uint32_t bucketCount = 8;
+        while (bucketCount < entries.size() * 2)
+        {
+            bucketCount *= 2;
+        }
+        std::vector<std::uint32_t> buckets(bucketCount, 0);
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            std::size_t slot = entries[i].hash & (bucketCount - 1);
+            while (buckets[slot] != 0)
+            {
+                slot = (slot + 1) & (bucketCount - 1);
+            }
+            buckets[slot] = static_cast<std::uint32_t>(i + 1);
+        }
+
+        DataHeader header{};
+        header.magic = kDataMagic;
+        header.version = kFormatVersion;
+        header.generation = generation() + 1;
+        header.entryCount = static_cast<std::uint32_t>(entries.size());
+        header.bucketCount = bucketCount;
+        header.entriesOffset = sizeof(DataHeader);
+        header.bucketsOffset = header.entriesOffset + entries.size() * sizeof(Entry);
+        header.stringsOffset = header.bucketsOffset + buckets.size() * sizeof(std::uint32_t);
+        header.size = header.stringsOffset + strings.size();
+
+        const std::string dataName = dataSegmentName(_name, header.generation);
+        shm_unlink(dataName.c_str()); // Leftover from a publisher that died mid-publish.
+        const int fd = shm_open(dataName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0)
+        {
+            throw shmError("Could not create shared memory segment", dataName);
+        }
+        if (ftruncate(fd, static_cast<off_t>(header.size)) != 0)
+        {
+            const auto error = shmError("Could not size shared memory segment", dataName);
+            close(fd);
+            shm_unlink(dataName.c_str());
+            throw error;
+        }
+
+        void *mapping = mmap(nullptr, header.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            const auto error = shmError("Could not map shared memory segment", dataName);
+            shm_unlink(dataName.c_str());
+            throw error;
+        }
+
+        auto *base = static_cast<char *>(mapping);
+        std::memcpy(base, &header, sizeof(header));
+        std::memcpy(base + header.entriesOffset, entries.data(), entries.size() * sizeof(Entry));
+        std::memcpy(base + header.bucketsOffset, buckets.data(), buckets.size() * sizeof(std::uint32_t));
+        std::memcpy(base + header.stringsOffset, strings.data(), strings.size());
+        munmap(mapping, header.size);
+
+        // The segment is complete: make it current, then retire the previous name.
+        static_cast<ControlBlock *>(_control)->generation.store(header.generation, std::memory_order_release);
+        if (header.generation > 1)
+        {
+            shm_unlink(dataSegmentName(_name, header.generation - 1).c_str());
+        }
+
+        return header.generation;
+    }
+
+    void SharedConfigPublisher::unpublish()
+    {
+        const std::uint64_t current = generation();
+        if (current > 0)
+        {
+            shm_unlink(dataSegmentName(_name, current).c_str());
+        }
+        shm_unlink(_name.c_str());
+    }
+
+    SharedConfigReader::SharedConfigReader(const std::string &name)
+        : _name(segmentName(name))
+    {
+        const int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+        {
+            throw shmError("Could not open shared memory segment", _name);
+        }
+
+        _control = mmap(nullptr, sizeof(ControlBlock), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (_control == MAP_FAILED)
+        {
+            _control = nullptr;
+            throw shmError("Could not map shared memory segment", _name);
+        }
+
+        if (control(_control)->magic != kControlMagic || control(_control)->version != kFormatVersion || !refresh())
+        {
+            munmap(_control, sizeof(ControlBlock));
+            _control = nullptr;
+            throw std::runtime_error("No configuration published in shared memory segment: " + _name);
+        }
+    }
+
+    SharedConfigReader::~SharedConfigReader()
+    {
+        unmap();
+        if (_control)
+        {
+            munmap(_control, sizeof(ControlBlock));
+        }
+    }
+
+    void SharedConfigReader::unmap()
+    {
+        if (_data)
+        {
+            munmap(const_cast<char *>(_data), _dataSize);
+            _data = nullptr;
+            _dataSize = 0;
+        }
+    }
+
+    /** @brief
+     * Maps the latest published generation if it differs from the mapped one.
+     * A generation can be retired between reading its number and opening it; the read is then
+     * simply retried with the newer number.
+     *
+     * @return True if a new generation was mapped.
+     * @throw std::runtime_error If a data segment is unreadable or malformed.
+     */
+    bool SharedConfigReader::refresh()
+    {
+        for (int attempt = 0; attempt < 16; ++attempt)
+        {
+            const std::uint64_t latest = control(_control)->generation.load(std::memory_order_acquire);
+            if (latest == 0 || latest == _generation)
+            {
+                return false;
+            }
+
+            const std::string dataName = dataSegmentName(_name, latest);
+            const int fd = shm_open(dataName.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+            {
+                if (errno == ENOENT)
+                {
+                    continue;
+                }
+                throw shmError("Could not open shared memory segment", dataName);
+            }
+
+            struct stat info;
+            if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(DataHeader))
+            {
+                close(fd);
+                throw std::runtime_error("Malformed shared memory segment: " + dataName);
+            }
+
+            const std::size_t size = static_cast<std::size_t>(info.st_size);
+            void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            if (mapping == MAP_FAILED)
+            {
+                throw shmError("Could not map shared memory segment", dataName);
+            }
+
+            const auto *header = static_cast<const DataHeader *>(mapping);
+            if (header->magic != kDataMagic || header->version != kFormatVersion ||
+                header->generation != latest || header->size > size)
+            {
+                munmap(mapping, size);
+                throw std::runtime_error("Malformed shared memory segment: " + dataName);
+            }
+
+            unmap();
+            _data = static_cast<const char *>(mapping);
+            _dataSize = size;
+            _generation = latest;
+            return true;
+        }
+
+        throw std::runtime_error("Could not attach to the latest generation of: " + _name);
+    }
+
+    /** @brief
+     * Looks a value up directly in the mapped segment: one hash, then a linear probe.
+     *
+     * @return A view into shared memory, valid until the next successful refresh().
+     */
+    std::optional<std::string_view> SharedConfigReader::find(std::string_view section, std::string_view key) const
+    {
+        const auto *header = reinterpret_cast<const DataHeader *>(_data);
+        const auto *entries = reinterpret_cast<const Entry *>(_data + header->entriesOffset);
+        const auto *buckets = reinterpret_cast<const std::uint32_t *>(_data + header->bucketsOffset);
+        const char *strings = _data + header->stringsOffset;
+
+        const std::uint64_t hash = entryHash(section, key);
+        const std::size_t mask = header->bucketCount - 1;
+        for (std::size_t slot = hash & mask; buckets[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const Entry &entry = entries[buckets[slot] - 1];
+            if (entry.hash == hash &&
+                std::string_view(strings + entry.sectionOffset, entry.sectionLength) == section &&
+                std::string_view(strings + entry.keyOffset, entry.keyLength) == key)
+            {
+                return std::string_view(strings + entry.valueOffset, entry.valueLength);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /** @brief
+     * Same as find().
+     * @throw std::runtime_error If the section or key does not exist.
+     */
+    std::string_view SharedConfigReader::get(std::string_view section, std::string_view key) const
+    {
+        const auto value = find(section, key);
+        if (!value)
+        {
+            throw std::runtime_error("Error retrieving " + std::string(section) + "." + std::string(key) +
+                                     " from shared config " + _name);
+        }
+        return *value;
+    }
+
+    std::size_t SharedConfigReader::size() const
+    {
+        return reinterpret_cast<const DataHeader *>(_data)->entryCount;
+    }
+
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>> SharedConfigReader::toMap() const
+    {
+        const auto *header = reinterpret_cast<const DataHeader *>(_data);
+        const auto *entries = reinterpret_cast<const Entry *>(_data + header->entriesOffset);
+        const char *strings = _data + header->stringsOffset;
+
+        std::unordered_map<std::string, std::unordered_map<std::string, std::string>> configMap;
+        for (std::uint32_t i = 0; i < header->entryCount; ++i)
+        {
+            const Entry &entry = entries[i];
+            configMap[std::string(strings + entry.sectionOffset, entry.sectionLength)]
+                     [std::string(strings + entry.keyOffset, entry.keyLength)] =
+                         std::string(strings + entry.valueOffset, entry.valueLength);
+        }
+        return configMap;
+    }
+} // ! EasyJson namespace
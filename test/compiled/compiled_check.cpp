@@ -0,0 +1,61 @@
+/**
+ * @file compiled_check.cpp
+ *
+ * Build check for easyjson_compile: escapes.json and lenient.json are compiled by
+ * easyjson_compile_config() and the generated headers are verified at compile time, so a
+ * generator or escaping regression fails the build of this file. The run-time part covers
+ * lookups with non-constant arguments.
+ *
+ * (C) 2023 Wilfrantz Dede
+ */
+
+#include <easyjson_compiled/escapes.h>
+#include <easyjson_compiled/lenient.h>
+
+#include <cstdlib>
+#include <string>
+
+using easyjson::compiled::escapes;
+using easyjson::compiled::lenient;
+using namespace std::string_view_literals;
+
+static_assert(escapes.size() == 8);
+
+// Quotes and backslashes, in values and in keys.
+static_assert(escapes.get("quotes", "say") == "he said \"hi\""sv);
+static_assert(escapes.get("quotes", "key \"quoted\"") == "'single'"sv);
+static_assert(escapes.get("paths", "windows") == "C:\\config\\easyjson"sv);
+static_assert(escapes.get("paths", "trailing") == "ends with \\"sv);
+
+// Non-ASCII bytes are written as octal escapes; a digit right after one must stay a digit.
+static_assert(escapes.get("unicode", "greeting") == "h\xc3\xa9llo w\xc3\xb6rld \xe6\x97\xa5\xe6\x9c\xac"sv);
+static_assert(escapes.get("unicode", "octal_digit") == "\xc3\xa9" "1"sv);
+
+// Control characters and empty values.
+static_assert(escapes.get("control", "lines") == "a\nb\tc"sv);
+static_assert(escapes.get("control", "empty").empty());
+static_assert(!escapes.contains("control", "missing"));
+static_assert(!escapes.contains("missing", "lines"));
+
+// Entries are sorted by section, then key.
+static_assert(escapes.begin()->section == "control"sv && escapes.begin()->key == "empty"sv);
+
+// A byte order mark and trailing commas load at run time, so they compile as well.
+static_assert(lenient.size() == 2);
+static_assert(lenient.get("server", "port") == "8080"sv);
+static_assert(lenient.get("server", "domain") == "example.com"sv);
+
+int main()
+{
+    // Every entry is found through its hash slot with run-time keys as well.
+    for (const auto &entry : escapes)
+    {
+        const std::string section(entry.section);
+        const std::string key(entry.key);
+        if (escapes.find(section, key) != entry.value)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    return escapes.toMap().at("quotes").at("say") == "he said \"hi\"" ? EXIT_SUCCESS : EXIT_FAILURE;
+}
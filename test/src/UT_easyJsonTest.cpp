@@ -109,3 +109,837 @@ TEST_F(EasyJsonMock, parseObjectMemberDataPassed)
 
     ASSERT_TRUE(ease._mainMap.empty());
 }
+
+// Writes a configuration file with the given number of sections and returns its path.
+static std::string writeConfigFile(const std::string &name, int sections)
+{
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream file(path);
+
+    file << "[";
+    for (int i = 0; i < sections; ++i)
+    {
+        file << (i ? "," : "") << R"({"section)" << i << R"(": {"action": "POST", "port": )" << i
+             << R"(, "endpoint": "https://example.com/)" << name << "/" << i << R"("}})";
+    }
+    file << "]";
+
+    return path.string();
+}
+
+// Test case for the loadConfigurationAsync method: PASSED
+TEST_F(EasyJsonMock, loadConfigurationAsyncPassed)
+{
+    const std::string path = writeConfigFile("easyjson_async.json", 8);
+
+    EasyJsonCPP syncLoader(path);
+    EasyJsonCPP asyncLoader(path);
+
+    auto future = asyncLoader.loadConfigurationAsync();
+    const auto config = future.get();
+
+    ASSERT_EQ(config, syncLoader.loadConfiguration());
+    ASSERT_EQ(config.at("section3").at("port"), "3");
+    std::filesystem::remove(path);
+}
+
+// Loads many files concurrently through loadConfigurationAsync and checks every result.
+static void loadConcurrently(const std::string &prefix)
+{
+    constexpr int loads = 200;
+
+    std::vector<std::string> paths;
+    std::vector<std::unique_ptr<EasyJsonCPP>> loaders;
+    for (int i = 0; i < loads; ++i)
+    {
+        // Mix small files with a few large ones that need several reads.
+        paths.push_back(writeConfigFile(prefix + std::to_string(i) + ".json", i % 50 ? 4 : 20000));
+        loaders.push_back(std::make_unique<EasyJsonCPP>(paths.back()));
+    }
+
+    std::vector<std::future<std::unordered_map<std::string, std::unordered_map<std::string, std::string>>>> futures;
+    for (auto &loader : loaders)
+    {
+        futures.push_back(loader->loadConfigurationAsync());
+    }
+
+    for (int i = 0; i < loads; ++i)
+    {
+        const auto config = futures[i].get();
+        ASSERT_EQ(config.size(), static_cast<std::size_t>(i % 50 ? 4 : 20000));
+        ASSERT_EQ(config.at("section1").at("endpoint"),
+                  "https://example.com/" + prefix + std::to_string(i) + ".json/1");
+        std::filesystem::remove(paths[i]);
+    }
+}
+
+// Test case for many concurrent loadConfigurationAsync calls: PASSED
+TEST_F(EasyJsonMock, loadConfigurationAsyncConcurrent)
+{
+    loadConcurrently("easyjson_async_");
+}
+
+// Test case for many concurrent loadConfigurationAsync calls without io_uring: PASSED
+TEST_F(EasyJsonMock, loadConfigurationAsyncConcurrentPool)
+{
+    struct PoolOnly
+    {
+        PoolOnly() { detail::setIoUringEnabled(false); }
+        ~PoolOnly() { detail::setIoUringEnabled(true); }
+    } poolOnly;
+
+    ASSERT_FALSE(detail::ioUringAvailable());
+    loadConcurrently("easyjson_pool_");
+}
+
+// Test case for the loadConfigurationAsync method: FAILED
+TEST_F(EasyJsonMock, loadConfigurationAsyncFailed)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "easyjson_missing.json").string();
+
+    EasyJsonCPP loader(path);
+    auto future = loader.loadConfigurationAsync();
+
+    try
+    {
+        future.get();
+        FAIL() << "Expected std::runtime_error";
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::string error("Error processing configuration file: Could not open config file: " + path);
+        ASSERT_EQ(e.what(), error);
+    }
+}
+
+// Test case for interned loading: PASSED
+TEST_F(EasyJsonMock, internedLoadPassed)
+{
+    std::string jsonString = R"([
+        {"twitter" : {"action" : "POST", "api_key" : "key1", "port" : 8080}},
+        {"tiktok" : {"Action" : "POST", "api_key" : "key2"}},
+        {"instagram" : {"Action" : "GET", "api_key" : "key1"}}
+    ])";
+
+    Json::Value objects;
+    std::istringstream(jsonString) >> objects;
+
+    EasyJsonCPP loader;
+    loader.setInterning(true);
+    ASSERT_NO_THROW(loader.parseArrayObjectData(objects));
+
+    ASSERT_TRUE(loader._mainMap.empty());
+    ASSERT_EQ(loader.getInterned("twitter", "action"), "POST");
+    ASSERT_EQ(loader.getInterned("twitter", "port"), "8080");
+    ASSERT_EQ(loader.getInterned("instagram", "Action"), "GET");
+
+    // Identical values share one ID, and one copy in the pool.
+    ASSERT_EQ(loader.getInternedId("twitter", "action"), loader.getInternedId("tiktok", "Action"));
+    ASSERT_EQ(loader.getInternedId("twitter", "api_key"), loader.getInternedId("instagram", "api_key"));
+    ASSERT_NE(loader.getInternedId("twitter", "api_key"), loader.getInternedId("tiktok", "api_key"));
+    ASSERT_EQ(loader.getInterned("twitter", "action").data(), loader.getInterned("tiktok", "Action").data());
+
+    // Missing member or key.
+    ASSERT_EQ(loader.getInternedId("facebook", "action"), StringPool::npos);
+    ASSERT_TRUE(loader.getInterned("twitter", "missing").empty());
+}
+
+// Test case for loading a file into the interned store: PASSED
+TEST_F(EasyJsonMock, loadInternedPassed)
+{
+    const std::string path = writeConfigFile("easyjson_interned.json", 4);
+
+    EasyJsonCPP loader(path);
+    loader.setInterning(true);
+    ASSERT_THROW(loader.loadConfiguration(), std::runtime_error);
+    ASSERT_EQ(loader.loadInterned(), 12u); // Four sections of three keys.
+    ASSERT_EQ(loader.getInterned("section2", "port"), "2");
+
+    // A moved-from pool is empty and reusable; it must not write into the new owner's blocks.
+    StringPool pool;
+    const StringPool::Id first = pool.intern("first");
+    StringPool moved(std::move(pool));
+    ASSERT_EQ(pool.size(), 0u);
+    ASSERT_EQ(pool.intern("other"), 0u);
+    ASSERT_EQ(moved.view(first), "first");
+    ASSERT_EQ(moved.intern("second"), 1u);
+    ASSERT_EQ(moved.view(first), "first");
+
+    pool = std::move(moved);
+    ASSERT_EQ(pool.view(1), "second");
+    ASSERT_EQ(moved.size(), 0u);
+    std::filesystem::remove(path);
+}
+
+// Test case for the loadFromBuffer method: PASSED
+TEST_F(EasyJsonMock, loadFromBufferPassed)
+{
+    const std::string buffer = R"([
+        {"twitter" : {"action" : "POST", "port" : 8080, "path" : "C:\\output\\twitter"}},
+        {"tiktok" : {"Action" : "GET"}}
+    ])";
+
+    EasyJsonCPP loader;
+    const auto &config = loader.loadFromBuffer(buffer);
+
+    ASSERT_EQ(config.size(), 2u);
+    ASSERT_EQ(loader.getFromBuffer("twitter", "action"), "POST");
+    ASSERT_EQ(loader.getFromBuffer("twitter", "port"), "8080");
+    ASSERT_EQ(loader.getFromBuffer("tiktok", "Action"), "GET");
+
+    // Plain strings and integers are views into the caller's buffer.
+    const auto inBuffer = [&buffer](std::string_view view)
+    {
+        return view.data() >= buffer.data() && view.data() + view.size() <= buffer.data() + buffer.size();
+    };
+    ASSERT_TRUE(inBuffer(config.at("twitter").at("action")));
+    ASSERT_TRUE(inBuffer(config.at("twitter").at("port")));
+
+    // Escaped strings are decoded into storage owned by the loader.
+    ASSERT_EQ(loader.getFromBuffer("twitter", "path"), "C:\\output\\twitter");
+    ASSERT_FALSE(inBuffer(config.at("twitter").at("path")));
+
+    ASSERT_TRUE(loader.getFromBuffer("twitter", "missing").empty());
+}
+
+// Test case for the loadFromOwnedBuffer method: PASSED
+TEST_F(EasyJsonMock, loadFromOwnedBufferPassed)
+{
+    EasyJsonCPP loader;
+    {
+        std::string buffer = R"([{"server" : {"port" : "8080", "domain" : "example.com"}}])";
+        loader.loadFromOwnedBuffer(std::move(buffer));
+    }
+    loader.loadFromOwnedBuffer(R"([{"telegram" : {"token" : "1234567890:ABCDEFGHIJKLMN"}}])");
+
+    ASSERT_EQ(loader.getFromBuffer("server", "domain"), "example.com");
+    ASSERT_EQ(loader.getFromBuffer("telegram", "token"), "1234567890:ABCDEFGHIJKLMN");
+
+    // Reloads release the buffers whose values have all been overridden.
+    const std::size_t kept = loader.ownedBufferBytes();
+    std::string reload;
+    for (int i = 0; i < 50; ++i)
+    {
+        reload = R"([{"server" : {"port" : ")" + std::to_string(i) + R"(", "domain" : "example.com"}}])";
+        loader.loadFromOwnedBuffer(reload);
+    }
+    ASSERT_EQ(loader.getFromBuffer("server", "port"), "49");
+    ASSERT_EQ(loader.getFromBuffer("telegram", "token"), "1234567890:ABCDEFGHIJKLMN");
+    ASSERT_LT(loader.ownedBufferBytes(), kept + reload.size() + 1);
+
+    loader.clearBufferStore();
+    ASSERT_EQ(loader.ownedBufferBytes(), 0u);
+    ASSERT_TRUE(loader.getFromBuffer("server", "port").empty());
+}
+
+// Test case for the loadFromBuffer method: FAILED
+TEST_F(EasyJsonMock, loadFromBufferFailed)
+{
+    EasyJsonCPP loader;
+
+    ASSERT_THROW(loader.loadFromBuffer(R"([{"server" : {"port" : )"), std::runtime_error);
+    ASSERT_THROW(loader.loadFromBuffer(R"([{"server" : {"port" : 3.14}}])"), std::runtime_error);
+    ASSERT_THROW(loader.loadFromOwnedBuffer(""), std::runtime_error);
+}
+
+// Test case for a buffer that fails after some values were stored: FAILED
+TEST_F(EasyJsonMock, loadFromBufferPartialFailed)
+{
+    EasyJsonCPP loader;
+    loader.loadFromOwnedBuffer(R"([{"s" : {"k" : "kept", "other" : "kept too"}}])");
+
+    // The first element is valid and gets stored before the second one is rejected.
+    const std::string value(256, 'x');
+    ASSERT_THROW(loader.loadFromOwnedBuffer(R"([{"s" : {"k" : ")" + value + R"("}, "t" : {"k" : "new"}}, 42])"),
+                 std::runtime_error);
+    ASSERT_EQ(loader.getFromBuffer("s", "k"), "kept");
+    ASSERT_TRUE(loader.getFromBuffer("t", "k").empty());
+
+    const std::string transient = R"([{"t" : {"k" : "new"}}, 42])";
+    ASSERT_THROW(loader.loadFromBuffer(transient), std::runtime_error);
+    ASSERT_TRUE(loader.getFromBuffer("t", "k").empty());
+
+    // A successful load merges: new keys are added, existing ones overridden, others kept.
+    loader.loadFromOwnedBuffer(R"([{"s" : {"k" : "replaced"}, "t" : {"k" : "new"}}])");
+    ASSERT_EQ(loader.getFromBuffer("s", "k"), "replaced");
+    ASSERT_EQ(loader.getFromBuffer("s", "other"), "kept too");
+    ASSERT_EQ(loader.getFromBuffer("t", "k"), "new");
+}
+
+// Test case for layered configurations: PASSED
+TEST_F(EasyJsonMock, layeredConfigPassed)
+{
+    const LayeredConfig base = LayeredConfig::fromMap({
+        {"server", {{"port", "8080"}, {"domain", "example.com"}}},
+        {"twitter", {{"action", "POST"}, {"api_key", "base-key"}}},
+    });
+
+    const LayeredConfig tenant = base.withOverrides({{"twitter", {{"api_key", "tenant-key"}}}});
+    const LayeredConfig region = tenant.withOverrides({{"server", {{"domain", "eu.example.com"}}},
+                                                       {"telegram", {{"token", "123:ABC"}}}});
+
+    ASSERT_EQ(region.layerCount(), 3u);
+    ASSERT_EQ(region.sectionCount(), 3u);
+
+    // Overrides win, untouched keys of an overridden section are inherited.
+    ASSERT_EQ(region.get("twitter", "api_key"), "tenant-key");
+    ASSERT_EQ(region.get("twitter", "action"), "POST");
+    ASSERT_EQ(region.get("server", "domain"), "eu.example.com");
+    ASSERT_EQ(region.get("server", "port"), "8080");
+    ASSERT_EQ(region.get("telegram", "token"), "123:ABC");
+
+    // Lower layers are unchanged.
+    ASSERT_EQ(base.get("twitter", "api_key"), "base-key");
+    ASSERT_EQ(tenant.get("server", "domain"), "example.com");
+    ASSERT_EQ(tenant.find("telegram", "token"), nullptr);
+
+    // Keys already held as strings are looked up without a copy; every overload agrees.
+    const std::string apiKey = "api_key";
+    const std::string_view apiKeyView = apiKey;
+    ASSERT_EQ(region.find("twitter", apiKey), region.find("twitter", apiKeyView));
+    ASSERT_EQ(region.get("twitter", apiKey), "tenant-key");
+    ASSERT_EQ(region.find("missing", apiKeyView), nullptr);
+    ASSERT_THROW(region.get("twitter", std::string("missing")), std::runtime_error);
+
+    // Unchanged sections are shared, overridden ones are not.
+    ASSERT_TRUE(tenant.sharesSection(base, "server"));
+    ASSERT_FALSE(tenant.sharesSection(base, "twitter"));
+    ASSERT_TRUE(region.sharesSection(tenant, "twitter"));
+
+    ASSERT_EQ(region.toMap().at("server").at("domain"), "eu.example.com");
+    ASSERT_THROW(region.get("server", "missing"), std::runtime_error);
+}
+
+// Test case for the validate method: PASSED
+TEST_F(EasyJsonMock, validatePassed)
+{
+    const auto result = EasyJsonCPP::validate(R"([{"server" : {"port" : 8080, "domain" : "example.com"}}])");
+    ASSERT_TRUE(result.ok());
+}
+
+// Test case for the validate method, collecting every error: FAILED
+TEST_F(EasyJsonMock, validateCollectAllFailed)
+{
+    const std::string content = "[\n"
+                                "  {\"server\" : {\"port\" : 3.14}},\n"
+                                "  {\"twitter\" : \"POST\"},\n"
+                                "  {\"tiktok\" : [{\"Action\" : \"GET\"}, 7]}\n"
+                                "]";
+
+    const auto first = EasyJsonCPP::validate(content);
+    ASSERT_EQ(first.errors.size(), 1u);
+
+    const auto result = EasyJsonCPP::validate(content, true);
+    ASSERT_EQ(result.errors.size(), 3u);
+
+    ASSERT_EQ(result.errors[0].code, ErrorCode::InvalidValue);
+    ASSERT_EQ(result.errors[0].path, "$[0].server.port");
+    ASSERT_EQ(result.errors[0].line, 2u);
+    ASSERT_EQ(result.errors[0].column, 25u);
+    ASSERT_EQ(result.errors[0].message, "Invalid format for object value in configuration file.");
+
+    ASSERT_EQ(result.errors[1].code, ErrorCode::InvalidMemberValue);
+    ASSERT_EQ(result.errors[1].path, "$[1].twitter");
+    ASSERT_EQ(result.errors[1].line, 3u);
+
+    ASSERT_EQ(result.errors[2].code, ErrorCode::InvalidObject);
+    ASSERT_EQ(result.errors[2].path, "$[2].tiktok[1]");
+    ASSERT_EQ(result.errors[2].line, 4u);
+    ASSERT_EQ(result.errors[2].column, 36u);
+}
+
+// Test case for the validate method on malformed JSON: FAILED
+TEST_F(EasyJsonMock, validateSyntaxFailed)
+{
+    const auto result = EasyJsonCPP::validate("[\n  {\"server\" : {\"port\" : }}\n]");
+
+    ASSERT_EQ(result.errors.size(), 1u);
+    ASSERT_EQ(result.errors[0].code, ErrorCode::SyntaxError);
+    ASSERT_EQ(result.errors[0].line, 2u);
+    ASSERT_EQ(result.errors[0].column, 25u);
+
+    ASSERT_EQ(EasyJsonCPP::validate("42").errors[0].code, ErrorCode::InvalidRoot);
+    ASSERT_EQ(EasyJsonCPP::validate("[]").errors[0].code, ErrorCode::EmptyRoot);
+    ASSERT_EQ(EasyJsonCPP::validateFile("/nonexistent/easyjson.json").errors[0].code, ErrorCode::FileError);
+}
+
+// Test case for validation and loading agreeing on the same text: PASSED
+TEST_F(EasyJsonMock, validateMatchesLoaderPassed)
+{
+    const std::vector<std::string> accepted = {
+        "\xEF\xBB\xBF[{\"server\" : {\"port\" : \"8080\"}}]", // UTF-8 byte order mark
+        "[{\"server\" : {\"port\" : \"8080\",}}]",             // Trailing comma
+    };
+    for (const auto &text : accepted)
+    {
+        ASSERT_TRUE(EasyJsonCPP::validate(text).ok()) << text;
+        EasyJsonCPP loader;
+        ASSERT_EQ(loader.loadFromBuffer(text).at("server").at("port"), "8080") << text;
+    }
+
+    const std::string rejected = "[{\"server\" : {\"port\" : }}]";
+    ASSERT_EQ(EasyJsonCPP::validate(rejected).errors.at(0).code, ErrorCode::SyntaxError);
+    EasyJsonCPP loader;
+    ASSERT_THROW(loader.loadFromBuffer(rejected), std::runtime_error);
+}
+
+// Test case for the tryLoadConfiguration method: PASSED
+TEST_F(EasyJsonMock, tryLoadConfigurationPassed)
+{
+    const std::string path = writeConfigFile("easyjson_try_load.json", 3);
+
+    EasyJsonCPP loader(path);
+    const auto result = loader.tryLoadConfiguration();
+
+    ASSERT_TRUE(result.ok());
+    ASSERT_EQ(loader._mainMap.at("section2").at("port"), "2");
+    std::filesystem::remove(path);
+}
+
+// Test case for loading gzip-compressed configuration files: PASSED
+TEST_F(EasyJsonMock, loadCompressedConfigurationPassed)
+{
+    const std::string path = writeConfigFile("easyjson_compressed.json", 2000);
+    std::ifstream plain(path, std::ios::binary);
+    const std::string text((std::istreambuf_iterator<char>(plain)), std::istreambuf_iterator<char>());
+
+    // Two gzip members, as written by pigz or by concatenating .gz files.
+    const std::string gzPath = path + ".gz";
+    gzFile gz = gzopen(gzPath.c_str(), "wb");
+    ASSERT_NE(gz, nullptr);
+    ASSERT_EQ(gzwrite(gz, text.data(), static_cast<unsigned>(text.size() / 2)), static_cast<int>(text.size() / 2));
+    gzclose(gz);
+    gz = gzopen(gzPath.c_str(), "ab");
+    ASSERT_EQ(gzwrite(gz, text.data() + text.size() / 2, static_cast<unsigned>(text.size() - text.size() / 2)),
+              static_cast<int>(text.size() - text.size() / 2));
+    gzclose(gz);
+
+    const auto expected = EasyJsonCPP(path).loadConfiguration();
+    EasyJsonCPP loader(gzPath);
+    ASSERT_EQ(loader.loadConfiguration(), expected);
+    ASSERT_EQ(loader.loadConfigurationAsync().get(), expected);
+    ASSERT_TRUE(EasyJsonCPP::validateFile(gzPath).ok());
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(gzPath);
+}
+
+// Test case for loading corrupt gzip-compressed configuration files: FAILED
+TEST_F(EasyJsonMock, loadCompressedConfigurationFailed)
+{
+    const std::string text = "[{\"server\" : {\"port\" : \"8080\"}}]";
+    std::vector<Bytef> compressed(compressBound(text.size()));
+    uLongf size = compressed.size();
+    ASSERT_EQ(compress(compressed.data(), &size, reinterpret_cast<const Bytef *>(text.data()), text.size()), Z_OK);
+
+    // zlib-wrapped data is detected too; a truncated stream is an error, not a short document.
+    const std::string path = std::filesystem::temp_directory_path() / "easyjson_truncated.json.z";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(compressed.data()), size - 6);
+
+    EasyJsonCPP loader(path);
+    ASSERT_THROW(loader.loadConfiguration(), std::runtime_error);
+    const auto result = EasyJsonCPP::validateFile(path);
+    ASSERT_EQ(result.errors.size(), 1u);
+    ASSERT_EQ(result.errors[0].code, ErrorCode::FileError);
+
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(compressed.data()), size);
+    ASSERT_EQ(loader.loadConfiguration().at("server").at("port"), "8080");
+    std::filesystem::remove(path);
+
+    // A forged gzip ISIZE trailer (4 GB) must not size the output buffer.
+    const std::string gzPath = std::filesystem::temp_directory_path() / "easyjson_forged.json.gz";
+    gzFile gz = gzopen(gzPath.c_str(), "wb");
+    ASSERT_NE(gz, nullptr);
+    gzwrite(gz, text.data(), static_cast<unsigned>(text.size()));
+    gzclose(gz);
+    {
+        std::fstream file(gzPath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-4, std::ios::end);
+        file.write("\xff\xff\xff\xff", 4);
+    }
+
+    rusage before{};
+    getrusage(RUSAGE_SELF, &before);
+    EasyJsonCPP forged(gzPath);
+    ASSERT_THROW(forged.loadConfiguration(), std::runtime_error);
+    rusage after{};
+    getrusage(RUSAGE_SELF, &after);
+    ASSERT_LT(after.ru_maxrss - before.ru_maxrss, 64 * 1024); // KB
+    std::filesystem::remove(gzPath);
+}
+
+// Laid out like a header generated by easyjson_compile: sorted entries plus their hash slots.
+namespace compiled_test
+{
+    constexpr CompiledEntry entries[] = {
+        {"server", "domain", "example.com"},
+        {"server", "port", "8080"},
+        {"twitter", "action", "POST"},
+    };
+
+    struct Slots
+    {
+        std::uint32_t values[8]{};
+    };
+
+    constexpr Slots makeSlots()
+    {
+        Slots slots{};
+        for (std::uint32_t i = 0; i < 3; ++i)
+        {
+            std::size_t index = CompiledConfig::hash(entries[i].section, entries[i].key) & 7;
+            while (slots.values[index] != 0)
+            {
+                index = (index + 1) & 7;
+            }
+            slots.values[index] = i + 1;
+        }
+        return slots;
+    }
+
+    constexpr Slots slots = makeSlots();
+    constexpr CompiledConfig config{entries, slots.values};
+} // ! compiled_test namespace
+
+// Test case for compiled configurations: PASSED
+TEST_F(EasyJsonMock, compiledConfigPassed)
+{
+    static_assert(compiled_test::config.get("server", "port") == "8080");
+    static_assert(compiled_test::config.contains("twitter", "action"));
+    static_assert(!compiled_test::config.contains("twitter", "port"));
+
+    const auto &config = compiled_test::config;
+    ASSERT_EQ(config.size(), 3u);
+    ASSERT_EQ(config.find("server", "domain").value(), "example.com");
+    ASSERT_FALSE(config.find("server", "address").has_value());
+    ASSERT_THROW(config.get("telegram", "token"), std::runtime_error);
+
+    const std::string text = "[{\"server\" : {\"port\" : \"8080\", \"domain\" : \"example.com\"}},"
+                             " {\"twitter\" : {\"action\" : \"POST\"}}]";
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>> expected;
+    EasyJsonCPP loader;
+    for (const auto &section : loader.loadFromBuffer(text))
+    {
+        for (const auto &entry : section.second)
+        {
+            expected[std::string(section.first)][std::string(entry.first)] = std::string(entry.second);
+        }
+    }
+    ASSERT_EQ(config.toMap(), expected);
+}
+
+// Test case for packed numeric arrays: PASSED
+TEST_F(EasyJsonMock, numericArrayPassed)
+{
+    const std::string text = "[{\"routing\" : {\"name\" : \"edge\", \"weights\" : [1, 2.5, -3],"
+                             " \"limits\" : [100, -200, 9223372036854775807], \"none\" : []}}]";
+    ASSERT_TRUE(EasyJsonCPP::validate(text).ok());
+
+    EasyJsonCPP loader;
+    loader.loadFromOwnedBuffer(text);
+
+    const ArrayView<std::int64_t> limits = loader.getInt64Array("routing", "limits");
+    ASSERT_EQ(limits.size(), 3u);
+    ASSERT_EQ(limits[1], -200);
+    ASSERT_EQ(limits.back(), INT64_MAX);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(limits.data()) % NumericArray::kAlignment, 0u);
+
+    // One real number makes the whole array double.
+    const ArrayView<double> weights = loader.getDoubleArray("routing", "weights");
+    ASSERT_EQ(std::vector<double>(weights.begin(), weights.end()), (std::vector<double>{1.0, 2.5, -3.0}));
+
+    ASSERT_TRUE(loader.getInt64Array("routing", "none").empty());
+    ASSERT_EQ(loader.findArray("routing", "name"), nullptr);
+    ASSERT_THROW(loader.getInt64Array("routing", "weights"), std::runtime_error);
+    ASSERT_THROW(loader.getDoubleArray("server", "weights"), std::runtime_error);
+
+    // A key holds one value: reloading it with the other type replaces the old one everywhere.
+    const auto parse = [](const std::string &jsonString)
+    {
+        Json::Value objects;
+        std::istringstream(jsonString) >> objects;
+        return objects;
+    };
+    EasyJsonCPP store;
+    store.addIndex("weights");
+    store.parseArrayObjectData(parse(R"([{"routing" : {"weights" : "1", "name" : "edge"}}])"));
+    store.parseArrayObjectData(parse(R"([{"routing" : {"weights" : [1, 2]}}])"));
+    ASSERT_EQ(store._mainMap.at("routing").count("weights"), 0u);
+    ASSERT_TRUE(store.findSections("weights", "1").empty());
+    ASSERT_EQ(store.getInt64Array("routing", "weights").size(), 2u);
+    store.parseArrayObjectData(parse(R"([{"routing" : {"weights" : "2"}}])"));
+    ASSERT_EQ(store.findArray("routing", "weights"), nullptr);
+    ASSERT_EQ(store.findSections("weights", "2"), (std::vector<std::string_view>{"routing"}));
+
+    loader.loadFromOwnedBuffer(R"([{"routing" : {"name" : [7], "limits" : "none"}}])");
+    ASSERT_EQ(loader.getInt64Array("routing", "name").front(), 7);
+    ASSERT_TRUE(loader.getFromBuffer("routing", "name").empty());
+    ASSERT_EQ(loader.getFromBuffer("routing", "limits"), "none");
+    ASSERT_EQ(loader.findArray("routing", "limits"), nullptr);
+}
+
+// Test case for non-numeric or mixed arrays: FAILED
+TEST_F(EasyJsonMock, numericArrayFailed)
+{
+    for (const std::string values : {"[1, \"2\"]", "[1, [2]]", "[1, {\"a\" : 2}]", "[18446744073709551615]"})
+    {
+        const std::string text = "[{\"routing\" : {\"weights\" : " + values + "}}]";
+
+        const auto result = EasyJsonCPP::validate(text);
+        ASSERT_EQ(result.errors.size(), 1u) << values;
+        ASSERT_EQ(result.errors[0].code, ErrorCode::InvalidValue);
+        ASSERT_EQ(result.errors[0].path, "$[0].routing.weights");
+
+        EasyJsonCPP loader;
+        ASSERT_THROW(loader.loadFromOwnedBuffer(text), std::runtime_error) << values;
+    }
+
+    // Arrays parsed before the error of a failed buffer load are not kept.
+    EasyJsonCPP loader;
+    ASSERT_THROW(loader.loadFromBuffer("[{\"s\" : {\"arr\" : [1, 2, 3]}}, 42]"), std::runtime_error);
+    ASSERT_EQ(loader.findArray("s", "arr"), nullptr);
+}
+
+// Test case for shared-memory publishing: PASSED
+TEST_F(EasyJsonMock, sharedConfigPassed)
+{
+    const std::string name = "easyjson_test_" + std::to_string(getpid());
+
+    SharedConfigPublisher publisher(name);
+    ASSERT_EQ(publisher.publish({{"server", {{"port", "8080"}, {"domain", "example.com"}}},
+                                 {"twitter", {{"action", "POST"}}}}),
+              1u);
+
+    SharedConfigReader reader(name);
+    ASSERT_EQ(reader.generation(), 1u);
+    ASSERT_EQ(reader.size(), 3u);
+    ASSERT_EQ(reader.get("server", "port"), "8080");
+    ASSERT_EQ(reader.get("twitter", "action"), "POST");
+    ASSERT_FALSE(reader.find("twitter", "port").has_value());
+    ASSERT_FALSE(reader.refresh());
+
+    // A worker process attaches and serves lookups from the same segment.
+    const pid_t child = fork();
+    if (child == 0)
+    {
+        SharedConfigReader worker(name);
+        _exit(worker.get("server", "domain") == "example.com" ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    // Republishing bumps the generation; readers switch over on refresh().
+    ASSERT_EQ(publisher.publish({{"server", {{"port", "9090"}}}}), 2u);
+    ASSERT_EQ(reader.get("server", "port"), "8080");
+    ASSERT_TRUE(reader.refresh());
+    ASSERT_EQ(reader.generation(), 2u);
+    ASSERT_EQ(reader.get("server", "port"), "9090");
+    ASSERT_EQ(reader.toMap().size(), 1u);
+
+    publisher.unpublish();
+    ASSERT_THROW(SharedConfigReader missing(name), std::runtime_error);
+}
+
+// Test case for secondary value indexes: PASSED
+TEST_F(EasyJsonMock, valueIndexPassed)
+{
+    const auto parse = [](const std::string &jsonString)
+    {
+        Json::Value objects;
+        std::istringstream(jsonString) >> objects;
+        return objects;
+    };
+    const auto sorted = [](std::vector<std::string_view> sections)
+    {
+        std::sort(sections.begin(), sections.end());
+        return sections;
+    };
+
+    EasyJsonCPP loader;
+    loader.addIndex("Action");
+    loader.parseArrayObjectData(parse(R"([
+        {"twitter" : {"Action" : "POST", "app_id" : "tw-1"}},
+        {"tiktok" : {"Action" : "POST", "app_id" : "tt-1"}},
+        {"instagram" : {"Action" : "GET", "app_id" : "ig-1"}}
+    ])"));
+
+    ASSERT_EQ(sorted(loader.findSections("Action", "POST")), (std::vector<std::string_view>{"tiktok", "twitter"}));
+    ASSERT_EQ(loader.findSections("Action", "GET"), (std::vector<std::string_view>{"instagram"}));
+    ASSERT_TRUE(loader.findSections("Action", "PUT").empty());
+    ASSERT_EQ(sorted(loader.findSections("Action", "POST")), sorted(loader.scanSections("Action", "POST")));
+
+    // Index declared after the load.
+    loader.addIndex("app_id");
+    ASSERT_EQ(loader.findSections("app_id", "tt-1"), (std::vector<std::string_view>{"tiktok"}));
+
+    // Reload with a changed value: the section moves to its new value's list.
+    loader.parseArrayObjectData(parse(R"([{"tiktok" : {"Action" : "GET", "app_id" : "tt-1"}}])"));
+    ASSERT_EQ(loader.findSections("Action", "POST"), (std::vector<std::string_view>{"twitter"}));
+    ASSERT_EQ(sorted(loader.findSections("Action", "GET")), (std::vector<std::string_view>{"instagram", "tiktok"}));
+    ASSERT_GT(loader.indexMemoryUsage(), 0u);
+
+    // Sections leaving the middle of a list, then coming back, keep every list consistent.
+    loader.parseArrayObjectData(parse(R"([{"instagram" : {"Action" : "POST"}}, {"instagram" : {"Action" : "PUT"}}])"));
+    loader.parseArrayObjectData(parse(R"([{"twitter" : {"Action" : "GET"}}, {"instagram" : {"Action" : "GET"}}])"));
+    ASSERT_EQ(sorted(loader.findSections("Action", "GET")),
+              (std::vector<std::string_view>{"instagram", "tiktok", "twitter"}));
+    ASSERT_TRUE(loader.findSections("Action", "POST").empty());
+    ASSERT_TRUE(loader.findSections("Action", "PUT").empty());
+    loader.parseArrayObjectData(parse(R"([{"tiktok" : {"Action" : "POST"}}])"));
+    ASSERT_EQ(sorted(loader.findSections("Action", "GET")), (std::vector<std::string_view>{"instagram", "twitter"}));
+    ASSERT_EQ(sorted(loader.findSections("Action", "GET")), sorted(loader.scanSections("Action", "GET")));
+
+    ASSERT_THROW(loader.findSections("MediaUrl", "x"), std::runtime_error);
+}
+
+// Test case for copying and moving a loaded object: PASSED
+TEST_F(EasyJsonMock, copyAndMovePassed)
+{
+    static_assert(std::is_copy_constructible_v<EasyJsonCPP> && std::is_copy_assignable_v<EasyJsonCPP>);
+    static_assert(std::is_move_constructible_v<EasyJsonCPP> && std::is_move_assignable_v<EasyJsonCPP>);
+
+    Json::Value objects;
+    std::istringstream(R"([
+        {"twitter" : {"Action" : "POST", "weights" : [1, 2, 3]}},
+        {"tiktok" : {"Action" : "GET"}}
+    ])") >> objects;
+
+    auto original = std::make_unique<EasyJsonCPP>();
+    original->addIndex("Action");
+    original->parseArrayObjectData(objects);
+    original->loadFromOwnedBuffer(R"([{"instagram" : {"app_id" : "ig-1"}}])");
+    original->optimizeLayout({{"tiktok", "Action"}}, 4);
+
+    EasyJsonCPP copy(*original);
+    EasyJsonCPP assigned;
+    assigned = *original;
+    original.reset();
+
+    for (const EasyJsonCPP *loader : {&copy, &assigned})
+    {
+        ASSERT_EQ(loader->findSections("Action", "POST"), (std::vector<std::string_view>{"twitter"}));
+        ASSERT_EQ(loader->getFromBuffer("instagram", "app_id"), "ig-1");
+        ASSERT_EQ(loader->getInt64Array("twitter", "weights").back(), 3);
+        ASSERT_EQ(loader->hotKeyCache().size(), 1u);
+        ASSERT_EQ(loader->lookup("tiktok", "Action"), "GET");
+    }
+
+    // A copy's index follows the copy, not the original.
+    Json::Value moved;
+    std::istringstream(R"([{"twitter" : {"Action" : "GET"}}])") >> moved;
+    assigned.parseArrayObjectData(moved);
+    ASSERT_TRUE(assigned.findSections("Action", "POST").empty());
+    ASSERT_EQ(copy.findSections("Action", "POST"), (std::vector<std::string_view>{"twitter"}));
+
+    EasyJsonCPP target(std::move(copy));
+    ASSERT_EQ(target.getFromBuffer("instagram", "app_id"), "ig-1");
+    ASSERT_EQ(target.findSections("Action", "POST"), (std::vector<std::string_view>{"twitter"}));
+    ASSERT_EQ(target.lookup("tiktok", "Action"), "GET");
+}
+
+// Test case for lookup profiling and the hot-key layout: PASSED
+TEST_F(EasyJsonMock, hotKeyLayoutPassed)
+{
+    const std::string path = writeConfigFile("easyjson_hot_keys.json", 50);
+    const std::string profile = (std::filesystem::temp_directory_path() / "easyjson_hot_keys.profile.json").string();
+
+    KeyProfiler &profiler = KeyProfiler::instance();
+    profiler.reset();
+    profiler.enable(1);
+
+    EasyJsonCPP loader(path);
+    loader.loadConfiguration();
+    for (int i = 0; i < 100; ++i)
+    {
+        loader.lookup("section7", "endpoint");
+        loader.lookup("section3", "port");
+    }
+    loader.lookup("section9", "action");
+    profiler.disable();
+
+    const auto report = profiler.report(2);
+    ASSERT_EQ(report.size(), 2u);
+    ASSERT_EQ(report[0].section, "section3");
+    ASSERT_EQ(report[0].key, "port");
+    ASSERT_EQ(report[0].count, 100u);
+    ASSERT_NE(profiler.dump().find("section7.endpoint"), std::string::npos);
+
+    loader.optimizeLayout(2);
+    ASSERT_EQ(loader.hotKeyCache().size(), 2u);
+    ASSERT_EQ(loader.lookup("section3", "port"), "3");
+    ASSERT_EQ(loader.lookup("section7", "endpoint"), "https://example.com/easyjson_hot_keys.json/7");
+    ASSERT_EQ(loader.lookup("section9", "action"), "POST");
+
+    // The layout built from the profiler survives a reload.
+    loader.loadConfiguration();
+    ASSERT_EQ(loader.hotKeyCache().size(), 2u);
+    ASSERT_EQ(loader.lookup("section3", "port"), "3");
+
+    // Only writes to the main map invalidate the cache; interned values are stored elsewhere.
+    gmock_processMemberData("section3", "port", Json::Value("3"));
+    easyJson->optimizeLayout({{"section3", "port"}});
+    ASSERT_EQ(easyJson->hotKeyCache().size(), 1u);
+    easyJson->setInterning(true);
+    gmock_processMemberData("section4", "port", Json::Value("4"));
+    ASSERT_EQ(easyJson->hotKeyCache().size(), 1u);
+    easyJson->setInterning(false);
+    gmock_processMemberData("section3", "port", Json::Value("33"));
+    ASSERT_TRUE(easyJson->hotKeyCache().empty());
+
+    // The saved profile is applied again after the next load.
+    loader.saveProfile(profile, 2);
+    EasyJsonCPP restarted(path);
+    restarted.loadProfile(profile);
+    ASSERT_TRUE(restarted.hotKeyCache().empty());
+    restarted.loadConfiguration();
+    ASSERT_EQ(restarted.hotKeyCache().size(), 2u);
+    ASSERT_EQ(restarted.lookup("section3", "port"), "3");
+    ASSERT_TRUE(restarted.lookup("section3", "missing").empty());
+
+    // Also on the non-throwing load path.
+    EasyJsonCPP validated(path);
+    validated.loadProfile(profile);
+    ASSERT_TRUE(validated.tryLoadConfiguration().ok());
+    ASSERT_EQ(validated.hotKeyCache().size(), 2u);
+
+    profiler.reset();
+    std::filesystem::remove(path);
+    std::filesystem::remove(profile);
+}
+
+// Test case for profiling lookups made by threads that have exited: PASSED
+TEST_F(EasyJsonMock, keyProfilerThreadsPassed)
+{
+    KeyProfiler &profiler = KeyProfiler::instance();
+    profiler.reset();
+    profiler.enable(1);
+
+    // Each short-lived worker leaves its samples behind when its table is retired.
+    for (int round = 0; round < 8; ++round)
+    {
+        std::vector<std::thread> workers;
+        for (int i = 0; i < 4; ++i)
+        {
+            workers.emplace_back([&profiler]
+                                 {
+                for (int j = 0; j < 10; ++j)
+                {
+                    profiler.record("server", "port");
+                } });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+    }
+    profiler.disable();
+
+    const auto report = profiler.report();
+    ASSERT_EQ(report.size(), 1u);
+    ASSERT_EQ(report[0].count, 8u * 4u * 10u);
+
+    profiler.reset();
+    ASSERT_TRUE(profiler.report().empty());
+}
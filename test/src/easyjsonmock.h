@@ -5,6 +5,13 @@
 #include <gmock/gmock.h>
 
 #include <easyjson.h>
+#include <easyjson_async.h>
+#include <easyjson_compiled.h>
+#include <easyjson_layers.h>
+#include <easyjson_shm.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <zlib.h>
 
 namespace easyjson
 {
@@ -0,0 +1,198 @@
+/**
+ * @file easyjson_compile.cpp
+ *
+ * Build-time compiler for EasyJsonCPP configuration files, driven by easyjson_compile_config().
+ * It validates the file with the same rules as loadConfiguration() and writes a header with
+ * the entries and their hash table as a constexpr CompiledConfig (see easyjson_compiled.h).
+ *
+ * Usage:
+ *     ./easyjson_compile <config.json> <output.h> <name>
+ *
+ *     <name>      C++ identifier of the generated easyjson::compiled::<name> object.
+ *
+ * The output is only rewritten when its content changes, so unchanged configurations do not
+ * trigger a rebuild of their users. Exit status is 0 on success, 1 when the configuration is
+ * invalid or holds no entries, and 2 on usage or I/O errors.
+ *
+ * @author: (C) 2023 Wilfrantz Dede
+ */
+
+#include <easyjson.h>
+#include <easyjson_compiled.h>
+#include <easyjson_compress.h>
+
+using namespace easyjson;
+
+namespace
+{
+    void usage()
+    {
+        std::cerr << "Usage: easyjson_compile <config.json> <output.h> <name>" << std::endl;
+    }
+
+    // Writes a C++ string literal; anything but printable ASCII is escaped in octal.
+    void writeLiteral(std::ostream &out, std::string_view text)
+    {
+        out << '"';
+        for (const char c : text)
+        {
+            const auto byte = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\')
+            {
+                out << '\\' << c;
+            }
+            else if (byte >= 0x20 && byte < 0x7f)
+            {
+                out << c;
+            }
+            else
+            {
+                out << '\\' << char('0' + (byte >> 6)) << char('0' + ((byte >> 3) & 7)) << char('0' + (byte & 7));
+            }
+        }
+        out << '"';
+    }
+
+    bool isIdentifier(const std::string &name)
+    {
+        return !name.empty() && !std::isdigit(static_cast<unsigned char>(name[0])) &&
+               std::all_of(name.begin(), name.end(), [](unsigned char c)
+                           { return std::isalnum(c) || c == '_'; });
+    }
+} // ! anonymous namespace
+
+int main(int argc, char **argv)
+{
+    if (argc != 4 || !isIdentifier(argv[3]))
+    {
+        usage();
+        return 2;
+    }
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+    const std::string name = argv[3];
+
+    std::string content;
+    try
+    {
+        content = detail::readConfigFile(input);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    const ValidationResult result = EasyJsonCPP::validate(content, true);
+    for (const auto &error : result.errors)
+    {
+        std::cerr << input << ":" << error.line << ":" << error.column << ": " << error.path
+                  << ": [" << EasyJsonCPP::errorCodeName(error.code) << "] " << error.message << "\n";
+    }
+    if (!result.ok())
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Same store as loadConfiguration(): later duplicates of a section or key win.
+    spdlog::set_level(spdlog::level::off);
+    EasyJsonCPP loader;
+    const auto &configMap = loader.loadFromBuffer(content);
+    if (!loader.numericArrays().empty())
+    {
+        const auto &section = *loader.numericArrays().begin();
+        std::cerr << input << ": " << section.first << "." << section.second.begin()->first
+                  << ": numeric arrays are not supported in compiled configurations" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<CompiledEntry> entries;
+    for (const auto &section : configMap)
+    {
+        for (const auto &entry : section.second)
+        {
+            entries.push_back({section.first, entry.first, entry.second});
+        }
+    }
+    // A compiled configuration needs at least one entry (see CompiledConfig). A root object
+    // passes validation but is not loaded, so it ends up here too.
+    if (entries.empty())
+    {
+        std::cerr << input << ": no entries to compile; the root must be an array of objects "
+                  << "holding key-value pairs" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const CompiledEntry &a, const CompiledEntry &b)
+              { return std::tie(a.section, a.key) < std::tie(b.section, b.key); });
+
+    std::string guard = "EASYJSON_COMPILED_" + name + "_H";
+    std::transform(guard.begin(), guard.end(), guard.begin(), [](unsigned char c)
+                   { return static_cast<char>(std::toupper(c)); });
+
+    std::ostringstream header;
+    header << "// Generated by easyjson_compile from " << std::filesystem::path(input).filename().string()
+           << ". Do not edit.\n\n"
+           << "#ifndef " << guard << "\n#define " << guard << "\n\n"
+           << "#include <easyjson_compiled.h>\n\n"
+           << "namespace easyjson::compiled\n{\n"
+           << "    inline constexpr CompiledEntry " << name << "_entries[] = {\n";
+    for (const auto &entry : entries)
+    {
+        header << "        {";
+        writeLiteral(header, entry.section);
+        header << ", ";
+        writeLiteral(header, entry.key);
+        header << ", ";
+        writeLiteral(header, entry.value);
+        header << "},\n";
+    }
+    header << "    };\n\n";
+
+    // Hash table at most half full, filled in entry order with linear probing.
+    std::size_t slotCount = 2;
+    while (slotCount < entries.size() * 2)
+    {
+        slotCount *= 2;
+    }
+    std::vector<std::uint32_t> slots(slotCount, 0);
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        std::size_t index = CompiledConfig::hash(entries[i].section, entries[i].key) & (slotCount - 1);
+        while (slots[index] != 0)
+        {
+            index = (index + 1) & (slotCount - 1);
+        }
+        slots[index] = static_cast<std::uint32_t>(i + 1);
+    }
+
+    header << "    inline constexpr std::uint32_t " << name << "_slots[] = {";
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        header << (i % 16 ? " " : "\n        ") << slots[i] << ",";
+    }
+    header << "\n    };\n\n"
+           << "    inline constexpr CompiledConfig " << name << "{" << name << "_entries, " << name << "_slots};\n"
+           << "} // ! compiled namespace\n\n"
+           << "#endif // " << guard << "\n";
+
+    // Leave the file (and its timestamp) alone when nothing changed.
+    const std::string text = header.str();
+    {
+        std::ifstream current(output, std::ios::in | std::ios::binary);
+        std::stringstream existing;
+        existing << current.rdbuf();
+        if (current.is_open() && existing.str() == text)
+        {
+            return EXIT_SUCCESS;
+        }
+    }
+
+    std::ofstream file(output, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open() || !(file << text))
+    {
+        std::cerr << "Could not write " << output << std::endl;
+        return 2;
+    }
+    return EXIT_SUCCESS;
+}
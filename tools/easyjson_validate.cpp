@@ -0,0 +1,162 @@
+/**
+ * @file easyjson_validate.cpp
+ *
+ * Command line checker for EasyJsonCPP configuration files. It validates every *.json,
+ * *.json.gz and *.json.zst file found under the given directories (and any file given
+ * directly) in parallel, using the non-throwing validation path, and prints each error as
+ * file:line:column: path: [code] message.
+ *
+ * Usage:
+ *     ./easyjson_validate [--all] [--jobs N] [--quiet] <directory|file>...
+ *
+ *     --all       Report every error of a file instead of only the first one.
+ *     --jobs N    Number of worker threads (default: number of hardware threads).
+ *     --quiet     Only print the summary line.
+ *
+ * Exit status is 0 when every file is valid, 1 when at least one file is invalid
+ * and 2 on usage errors.
+ *
+ * @author: (C) 2023 Wilfrantz Dede
+ */
+
+#include <easyjson.h>
+
+using namespace easyjson;
+
+namespace
+{
+    void usage()
+    {
+        std::cerr << "Usage: easyjson_validate [--all] [--jobs N] [--quiet] <directory|file>..." << std::endl;
+    }
+
+    // Configuration files, compressed or not; the loader detects the compression itself.
+    bool isConfigFile(const std::filesystem::path &path)
+    {
+        const std::string name = path.filename().string();
+        for (const std::string_view suffix : {".json", ".json.gz", ".json.zst"})
+        {
+            if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::string> collectFiles(const std::vector<std::string> &targets)
+    {
+        std::vector<std::string> files;
+        for (const auto &target : targets)
+        {
+            std::error_code error;
+            if (std::filesystem::is_directory(target, error))
+            {
+                for (const auto &entry : std::filesystem::recursive_directory_iterator(target, error))
+                {
+                    if (entry.is_regular_file() && isConfigFile(entry.path()))
+                    {
+                        files.push_back(entry.path().string());
+                    }
+                }
+            }
+            else
+            {
+                files.push_back(target);
+            }
+        }
+
+        std::sort(files.begin(), files.end());
+        return files;
+    }
+} // ! anonymous namespace
+
+int main(int argc, char **argv)
+{
+    bool collectAll = false;
+    bool quiet = false;
+    std::size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> targets;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--all")
+        {
+            collectAll = true;
+        }
+        else if (arg == "--quiet")
+        {
+            quiet = true;
+        }
+        else if (arg == "--jobs" && i + 1 < argc)
+        {
+            jobs = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--help" || arg == "-h" || (!arg.empty() && arg[0] == '-'))
+        {
+            usage();
+            return 2;
+        }
+        else
+        {
+            targets.push_back(arg);
+        }
+    }
+
+    if (targets.empty())
+    {
+        usage();
+        return 2;
+    }
+
+    const std::vector<std::string> files = collectFiles(targets);
+    std::vector<ValidationResult> results(files.size());
+
+    // Workers pull the next file index; results are printed in file order afterwards.
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<std::size_t> next{0};
+    std::vector<std::thread> workers;
+    for (std::size_t w = 0; w < std::min(jobs, files.size()); ++w)
+    {
+        workers.emplace_back([&]
+                             {
+            for (std::size_t i = next++; i < files.size(); i = next++)
+            {
+                results[i] = EasyJsonCPP::validateFile(files[i], collectAll);
+            } });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::size_t invalid = 0;
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        if (results[i].ok())
+        {
+            continue;
+        }
+
+        ++invalid;
+        if (quiet)
+        {
+            continue;
+        }
+        for (const auto &error : results[i].errors)
+        {
+            std::cout << files[i] << ":" << error.line << ":" << error.column << ": " << error.path
+                      << ": [" << EasyJsonCPP::errorCodeName(error.code) << "] " << error.message << "\n";
+        }
+    }
+
+    const double seconds = elapsed.count();
+    std::cout << "Checked " << files.size() << " files with " << workers.size() << " threads in "
+              << std::fixed << std::setprecision(3) << seconds << " s ("
+              << std::setprecision(0) << (seconds > 0 ? files.size() / seconds : 0.0) << " files/s), "
+              << invalid << " invalid." << std::endl;
+
+    return invalid ? EXIT_FAILURE : EXIT_SUCCESS;
+}